@@ -0,0 +1,265 @@
+#include <string>
+#include <memory>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include "../const.h"
+#include "../maze/generator.h"
+#include "../maze/maze_file.h"
+#include "../maze/thread_pool.h"
+
+/** Window width */
+int WINDOW_WIDTH = 1280;
+/** Window height */
+int WINDOW_HEIGHT = 720;
+/** Window X offset - Maze is drawn on the right square, rest of the screen is GUI on the left */
+int WINDOW_X_OFFSET = WINDOW_WIDTH - WINDOW_HEIGHT;
+/** Grid size for drawing */
+int GRID_SIZE = 50;
+/** Width of the lines representing the paths */
+float WHITE_LINE_WIDTH = (float) GRID_SIZE * 0.5f;
+/** Radius of the nodes (used to make the paths junctions look smooth) */
+float WHITE_NODE_RADIUS = WHITE_LINE_WIDTH / (float) WINDOW_HEIGHT;
+/** Radius of the player */
+float PLAYER_RADIUS = (float) GRID_SIZE * 0.25f / (float) WINDOW_HEIGHT;
+
+/**
+ * Output format of the generated mazes
+ */
+enum class OutputFormat {
+    NONE = 0,
+    BINARY = 1,
+    IMAGE = 2
+};
+
+/**
+ * Settings of a batch
+ */
+struct BatchSettings {
+    /** Lattice type */
+    GraphType type = GraphType::ORTHOGONAL;
+    /** Width of a maze */
+    int width = 100;
+    /** Height of a maze */
+    int height = 100;
+    /** Non-grid version of the lattice */
+    bool non_grid = false;
+    /** Generator algorithm */
+    GeneratorType generator = GeneratorType::KRUSKAL;
+    /** Horizontal bias (Kruskal's and Eller's algorithm) */
+    float horizontal_bias = 0.5f;
+    /** Vertical bias (Kruskal's and Eller's algorithm) */
+    float vertical_bias = 0.5f;
+    /** Cycle bias (Kruskal's algorithm) */
+    float cycle_bias = 0.0f;
+    /** Number of mazes */
+    int64_t count = 1;
+    /** Seed of the first maze, the maze i has the seed first_seed + i */
+    uint64_t first_seed = 0;
+    /** Number of threads (0 for the number of hardware threads) */
+    unsigned threads = 0;
+    /** Output format */
+    OutputFormat format = OutputFormat::BINARY;
+    /** Directory the mazes are written to */
+    std::string output_directory = ".";
+};
+
+/**
+ * Prints the usage of the program
+ * @param program Name of the program
+ */
+void print_usage(const char *program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --type orthogonal|hexagonal|laplacian   Lattice type (default: orthogonal)\n"
+              << "  --width N, --height N                   Size of a maze (default: 100 x 100)\n"
+              << "  --non-grid                              Randomly move the nodes a little bit\n"
+              << "  --generator dfs|kruskal|eller           Generator algorithm (default: kruskal)\n"
+              << "  --horizontal-bias F, --vertical-bias F  Biases of Kruskal's and Eller's algorithm (default: 0.5)\n"
+              << "  --cycle-bias F                          Cycle bias of Kruskal's algorithm (default: 0)\n"
+              << "  --count N                               Number of mazes (default: 1)\n"
+              << "  --seed N                                Seed of the first maze, the next ones count up (default: 0)\n"
+              << "  --threads N                             Number of threads (default: all hardware threads)\n"
+              << "  --format binary|image|none              Maze file, PGM image (orthogonal only) or nothing\n"
+              << "  --output DIR                            Directory of the written mazes (default: .)\n";
+}
+
+/**
+ * Parses the command line arguments
+ * @param argc Argument count
+ * @param argv Argument values
+ * @param settings Parsed settings (output)
+ * @return True if all the arguments are valid, false otherwise
+ */
+bool parse_arguments(int argc, char **argv, BatchSettings &settings) {
+    for (int i = 1; i < argc; i++) {
+        std::string name = argv[i];
+        if (name == "--non-grid") {
+            settings.non_grid = true;
+            continue;
+        }
+        if (i + 1 >= argc) // Every other option has a value
+            return false;
+        std::string value = argv[++i];
+        char *end = nullptr;
+
+        if (name == "--type") {
+            if (value == "orthogonal")
+                settings.type = GraphType::ORTHOGONAL;
+            else if (value == "hexagonal")
+                settings.type = GraphType::HEXAGONAL;
+            else if (value == "laplacian")
+                settings.type = GraphType::LAPLACIAN;
+            else
+                return false;
+        } else if (name == "--generator") {
+            if (value == "dfs")
+                settings.generator = GeneratorType::DEPTH_FIRST_SEARCH;
+            else if (value == "kruskal")
+                settings.generator = GeneratorType::KRUSKAL;
+            else if (value == "eller")
+                settings.generator = GeneratorType::ELLER;
+            else
+                return false;
+        } else if (name == "--format") {
+            if (value == "binary")
+                settings.format = OutputFormat::BINARY;
+            else if (value == "image")
+                settings.format = OutputFormat::IMAGE;
+            else if (value == "none")
+                settings.format = OutputFormat::NONE;
+            else
+                return false;
+        } else if (name == "--output") {
+            settings.output_directory = value;
+        } else if (name == "--width") {
+            settings.width = static_cast<int>(std::strtol(value.c_str(), &end, 10));
+        } else if (name == "--height") {
+            settings.height = static_cast<int>(std::strtol(value.c_str(), &end, 10));
+        } else if (name == "--count") {
+            settings.count = std::strtoll(value.c_str(), &end, 10);
+        } else if (name == "--seed") {
+            settings.first_seed = std::strtoull(value.c_str(), &end, 10);
+        } else if (name == "--threads") {
+            settings.threads = static_cast<unsigned>(std::strtoul(value.c_str(), &end, 10));
+        } else if (name == "--horizontal-bias") {
+            settings.horizontal_bias = std::strtof(value.c_str(), &end);
+        } else if (name == "--vertical-bias") {
+            settings.vertical_bias = std::strtof(value.c_str(), &end);
+        } else if (name == "--cycle-bias") {
+            settings.cycle_bias = std::strtof(value.c_str(), &end);
+        } else {
+            return false;
+        }
+
+        if (end && *end != '\0') // Numbers have to be whole arguments
+            return false;
+    }
+
+    // Images draw the walls between the cells, only the orthogonal lattice has no diagonal paths
+    if (settings.format == OutputFormat::IMAGE && settings.type != GraphType::ORTHOGONAL)
+        return false;
+    return settings.width > 0 && settings.height > 0 && settings.count >= 0;
+}
+
+/**
+ * Writes a maze on the orthogonal lattice as a PGM image (one pixel per cell and per wall)
+ * @param filename Name of the image file
+ * @param maze Maze
+ * @return True if the image was written, false otherwise
+ */
+bool write_image(const std::string &filename, const Graph &maze) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file)
+        return false;
+
+    // Walls are black, paths are white, the rows are written from the top
+    auto width = maze.get_width();
+    auto height = maze.get_height();
+    auto image_width = 2 * width + 1;
+    file << "P5\n" << image_width << " " << 2 * height + 1 << "\n255\n";
+    std::vector<char> cells(image_width, 0);
+    std::vector<char> walls(image_width, 0);
+    file.write(walls.data(), image_width); // Top border
+    for (int j = 0; j < height; j++) {
+        for (int i = 0; i < width; i++) {
+            auto mask = maze.get_open_mask(i * height + j);
+            cells[2 * i + 1] = static_cast<char>(255);
+            cells[2 * i + 2] = static_cast<char>(mask & (1 << 1) ? 255 : 0);
+            walls[2 * i + 1] = static_cast<char>(mask & (1 << 3) ? 255 : 0);
+        }
+        cells[image_width - 1] = 0;
+        file.write(cells.data(), image_width);
+        file.write(walls.data(), image_width);
+    }
+
+    return file.good();
+}
+
+/**
+ * Generates one maze of the batch and writes it out
+ * @param settings Settings of the batch
+ * @param seed Seed of the maze
+ * @return True if the maze was written, false otherwise
+ */
+bool produce_maze(const BatchSettings &settings, uint64_t seed) {
+    std::shared_ptr<Graph> graph;
+    if (settings.type == GraphType::ORTHOGONAL)
+        graph = Generator::create_orthogonal_grid_graph(settings.width, settings.height, settings.non_grid, seed);
+    else if (settings.type == GraphType::HEXAGONAL)
+        graph = Generator::create_hexagonal_grid_graph(settings.width, settings.height, settings.non_grid, seed);
+    else
+        graph = Generator::create_orthogonal_grid_graph_laplacian(settings.width, settings.height, settings.non_grid,
+                                                                  seed);
+
+    std::shared_ptr<Graph> maze;
+    if (settings.generator == GeneratorType::DEPTH_FIRST_SEARCH)
+        maze = Generator::generate_maze_dfs(graph, seed);
+    else if (settings.generator == GeneratorType::KRUSKAL)
+        maze = Generator::generate_maze_kruskal(graph, settings.horizontal_bias, settings.vertical_bias,
+                                                settings.cycle_bias, seed);
+    else
+        maze = Generator::generate_maze_eller(graph, settings.horizontal_bias, settings.vertical_bias, seed);
+
+    auto filename = settings.output_directory + "/maze_" + std::to_string(seed);
+    if (settings.format == OutputFormat::BINARY)
+        return MazeFile::save(filename + ".bin", maze, seed);
+    if (settings.format == OutputFormat::IMAGE)
+        return write_image(filename + ".pgm", *maze);
+    return true;
+}
+
+/**
+ * Headless batch production of mazes, this file is exclusive with the main.cpp file
+ * Every worker generates one maze at a time and writes it out before taking the next one,
+ * so the memory stays bounded by the number of threads times the size of one maze
+ * @param argc Argument count
+ * @param argv Argument values
+ * @return EXIT_SUCCESS if all the mazes were written
+ */
+int main(int argc, char **argv) {
+    BatchSettings settings;
+    if (!parse_arguments(argc, argv, settings)) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    ThreadPool pool(settings.threads);
+    std::atomic<int64_t> failed{0};
+    auto start = std::chrono::steady_clock::now();
+    pool.parallel_for(settings.count, [&](int64_t i) {
+        if (!produce_maze(settings, settings.first_seed + i))
+            failed++;
+    });
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    auto cells = static_cast<double>(settings.count) * settings.width * settings.height;
+    std::cout << settings.count << " mazes (" << settings.width << " x " << settings.height << ") on "
+              << pool.get_size() << " threads in " << seconds << " s\n"
+              << static_cast<double>(settings.count) / seconds << " mazes/s, " << cells / seconds << " cells/s\n";
+    if (failed > 0) {
+        std::cerr << failed << " mazes could not be written\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
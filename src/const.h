@@ -74,7 +74,8 @@ enum class NeighborhoodGraphType {
  */
 enum class GeneratorType {
     DEPTH_FIRST_SEARCH = 0,
-    KRUSKAL = 1
+    KRUSKAL = 1,
+    ELLER = 2
 };
 
 /**
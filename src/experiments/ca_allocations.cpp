@@ -0,0 +1,119 @@
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include "../maze/generator.h"
+#include "../maze/cellular_automata.h"
+
+/** Window width */
+int WINDOW_WIDTH = 1280;
+/** Window height */
+int WINDOW_HEIGHT = 720;
+/** Window X offset - Maze is drawn on the right square, rest of the screen is GUI on the left */
+int WINDOW_X_OFFSET = WINDOW_WIDTH - WINDOW_HEIGHT;
+/** Grid size for drawing */
+int GRID_SIZE = 50;
+/** Width of the lines representing the paths */
+float WHITE_LINE_WIDTH = (float) GRID_SIZE * 0.5f;
+/** Radius of the nodes (used to make the paths junctions look smooth) */
+float WHITE_NODE_RADIUS = WHITE_LINE_WIDTH / (float) WINDOW_HEIGHT;
+/** Radius of the player */
+float PLAYER_RADIUS = (float) GRID_SIZE * 0.25f / (float) WINDOW_HEIGHT;
+
+/** Number of allocations made so far */
+std::atomic<long> allocations{0};
+
+void *operator new(std::size_t size) {
+    allocations++;
+    if (auto p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+/**
+ * Path of the cellular automata a case is meant to run on
+ */
+enum class Path {
+    BITBOARD, // Lattice with the same lattice neighborhood, high churn
+    FULL, // Neighborhood of another size (explicit), high churn
+    ACTIVE // Maze rule, few changes after the first generations
+};
+
+/**
+ * Creates a lattice graph
+ * @param type Lattice type
+ * @param width Width of the graph
+ * @param height Height of the graph
+ * @return Graph
+ */
+std::shared_ptr<Graph> create_graph(GraphType type, int width, int height) {
+    if (type == GraphType::ORTHOGONAL)
+        return Generator::create_orthogonal_grid_graph(width, height);
+    if (type == GraphType::HEXAGONAL)
+        return Generator::create_hexagonal_grid_graph(width, height);
+    return Generator::create_orthogonal_grid_graph_laplacian(width, height);
+}
+
+/**
+ * Steps a cellular automata and counts the allocations of its steady-state generations
+ * Only the geometric growth of the delta lists (born, died, opened, closed) and of the active list is accepted,
+ * at most one allocation per doubling of each list, so the count is bounded independently of the number of generations
+ * @param type Lattice type of the graph and the neighborhood
+ * @param path Path of the cellular automata
+ * @return True if the allocations stay within the bound and the generations ran on the path, false otherwise
+ */
+bool check(GraphType type, Path path) {
+    constexpr int SIDE = 128;
+    constexpr int WARM_UP = 50;
+    constexpr int GENERATIONS = 200;
+    constexpr int ACTIVE_SET_DIVISOR = 16; // Same as the cellular automata
+
+    auto graph = create_graph(type, SIDE, SIDE);
+    auto neighborhood = path == Path::FULL ? create_graph(type, SIDE + 1, SIDE) : nullptr;
+    CellularAutomata ca(path == Path::ACTIVE ? "B3/S12345" : "B1357/S1357", graph, neighborhood, -1, 1);
+    for (int i = 0; i < WARM_UP; i++)
+        ca.next_generation();
+
+    // Generations with few changes go to the active set, the others to the full sweep
+    auto v = ca.get_graph()->get_v();
+    auto on_path = 0;
+    auto before = allocations.load();
+    for (int i = 0; i < GENERATIONS; i++) {
+        auto &last = ca.get_last_delta();
+        auto quiet = static_cast<int64_t>(last.born.size() + last.died.size()) * ACTIVE_SET_DIVISOR <= v;
+        ca.next_generation();
+        on_path += quiet == (path == Path::ACTIVE);
+    }
+    auto made = allocations.load() - before;
+
+    auto bound = 3 * (std::bit_width(static_cast<unsigned>(v)) + 1) +
+                 2 * (std::bit_width(static_cast<unsigned>(v * MAX_DEGREE)) + 1);
+    const char *types[] = {"orthogonal", "hexagonal", "laplacian"};
+    const char *paths[] = {"bitboard", "full", "active"};
+    std::cout << types[static_cast<int>(type)] << " " << paths[static_cast<int>(path)] << ": "
+              << made << " allocations in " << GENERATIONS << " generations (bound " << bound << "), " << on_path
+              << " generations on the path\n";
+    return made <= bound && on_path * 2 >= GENERATIONS;
+}
+
+int main() {
+    auto ok = true;
+    for (auto type: {GraphType::ORTHOGONAL, GraphType::HEXAGONAL, GraphType::LAPLACIAN})
+        for (auto path: {Path::BITBOARD, Path::FULL, Path::ACTIVE})
+            ok = check(type, path) && ok;
+
+    if (!ok) {
+        std::cerr << "Steady-state generations allocate\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
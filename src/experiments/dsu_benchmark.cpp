@@ -0,0 +1,183 @@
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+#include "../maze/generator.h"
+#include "../maze/disjoint_union_sets.h"
+#include "../maze/concurrent_disjoint_union_sets.h"
+#include "../maze/thread_pool.h"
+#include "../maze/philox.h"
+
+/** Window width */
+int WINDOW_WIDTH = 1280;
+/** Window height */
+int WINDOW_HEIGHT = 720;
+/** Window X offset - Maze is drawn on the right square, rest of the screen is GUI on the left */
+int WINDOW_X_OFFSET = WINDOW_WIDTH - WINDOW_HEIGHT;
+/** Grid size for drawing */
+int GRID_SIZE = 50;
+/** Width of the lines representing the paths */
+float WHITE_LINE_WIDTH = (float) GRID_SIZE * 0.5f;
+/** Radius of the nodes (used to make the paths junctions look smooth) */
+float WHITE_NODE_RADIUS = WHITE_LINE_WIDTH / (float) WINDOW_HEIGHT;
+/** Radius of the player */
+float PLAYER_RADIUS = (float) GRID_SIZE * 0.25f / (float) WINDOW_HEIGHT;
+
+/**
+ * Previous disjoint union sets (recursive find, union by rank, separate parent and rank vectors), kept as the baseline
+ */
+class Recursive_disjoint_union_sets {
+private:
+    /** Parent of each element */
+    std::vector<int> parent;
+    /** Rank of each element */
+    std::vector<int> rank;
+
+public:
+    /**
+     * Constructor
+     * @param size Size of the data structure
+     */
+    explicit Recursive_disjoint_union_sets(int size) : parent(size), rank(size, 0) {
+        for (int i = 0; i < size; i++)
+            parent[i] = i;
+    }
+
+    /**
+     * Find the parent of the given element
+     * @param x Element
+     * @return Parent of the element
+     */
+    int find(int x) {
+        if (parent[x] != x)
+            parent[x] = find(parent[x]);
+        return parent[x];
+    }
+
+    /**
+     * Merge two elements
+     * @param x Element
+     * @param y Element
+     */
+    void merge(int x, int y) {
+        int x_root = find(x);
+        int y_root = find(y);
+        if (x_root == y_root)
+            return;
+        if (rank[x_root] < rank[y_root])
+            parent[x_root] = y_root;
+        else if (rank[x_root] > rank[y_root])
+            parent[y_root] = x_root;
+        else {
+            parent[y_root] = x_root;
+            rank[x_root]++;
+        }
+    }
+};
+
+/**
+ * Measures the time of a function
+ * @tparam F Function type (void())
+ * @param f Function
+ * @return Time in milliseconds
+ */
+template<typename F>
+double measure(F &&f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Runs Kruskal's algorithm over the edges (connectivity only) with the given disjoint union sets
+ * @tparam DSU Disjoint union sets type
+ * @param sets Disjoint union sets
+ * @param edges Edges in the order they are tried
+ * @return Number of merged edges
+ */
+template<typename DSU>
+int64_t kruskal(DSU &sets, const std::vector<std::pair<int, int>> &edges) {
+    int64_t merged = 0;
+    for (auto &[x, y]: edges) {
+        if (sets.find(x) != sets.find(y)) {
+            sets.merge(x, y);
+            merged++;
+        }
+    }
+    return merged;
+}
+
+/**
+ * Benchmarks the disjoint union sets against the previous implementation
+ * This file is exclusive with the main.cpp file
+ * Workloads are Kruskal's algorithm over the shuffled edges of a grid, a long chain merged in order
+ * (deepest trees) and the concurrent variant merging the grid edges on all the hardware threads
+ * @return EXIT_SUCCESS if the program finishes successfully
+ */
+int main() {
+    constexpr int SIDE = 2000;
+    constexpr int V = SIDE * SIDE;
+    constexpr int REPETITIONS = 5;
+
+    // Shuffled edges of an orthogonal grid (deterministic)
+    auto grid = Generator::create_orthogonal_grid_graph(SIDE, SIDE, false, 0, 0);
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i < V; i++)
+        grid->for_each_neighbor(i, [&](int j) {
+            if (i < j)
+                edges.emplace_back(i, j);
+        });
+    Philox gen(0);
+    std::shuffle(edges.begin(), edges.end(), gen);
+
+    // Chain 0-1, 1-2, ... merged in order
+    std::vector<std::pair<int, int>> chain;
+    for (int i = 0; i + 1 < V; i++)
+        chain.emplace_back(i, i + 1);
+
+    double recursive_grid = 0, iterative_grid = 0, recursive_chain = 0, iterative_chain = 0;
+    double concurrent_serial = 0, concurrent_parallel = 0;
+    Disjoint_union_sets iterative(V);
+    Concurrent_disjoint_union_sets concurrent(V);
+    ThreadPool pool;
+    for (int r = 0; r < REPETITIONS; r++) {
+        recursive_grid += measure([&] {
+            Recursive_disjoint_union_sets sets(V);
+            kruskal(sets, edges);
+        });
+        iterative_grid += measure([&] {
+            iterative.reset();
+            kruskal(iterative, edges);
+        });
+        recursive_chain += measure([&] {
+            Recursive_disjoint_union_sets sets(V);
+            kruskal(sets, chain);
+        });
+        iterative_chain += measure([&] {
+            iterative.reset();
+            kruskal(iterative, chain);
+        });
+        concurrent_serial += measure([&] {
+            concurrent.reset();
+            for (auto &[x, y]: edges)
+                concurrent.merge(x, y);
+        });
+        concurrent_parallel += measure([&] {
+            concurrent.reset();
+            constexpr int64_t BLOCK = 65536;
+            pool.parallel_for((static_cast<int64_t>(edges.size()) + BLOCK - 1) / BLOCK, [&](int64_t block) {
+                auto last = std::min((block + 1) * BLOCK, static_cast<int64_t>(edges.size()));
+                for (auto e = block * BLOCK; e < last; e++)
+                    concurrent.merge(edges[e].first, edges[e].second);
+            });
+        });
+    }
+
+    std::cout << "Average of " << REPETITIONS << " runs, " << V << " elements, " << edges.size() << " grid edges\n"
+              << "Kruskal (grid)      recursive " << recursive_grid / REPETITIONS << " ms, iterative "
+              << iterative_grid / REPETITIONS << " ms\n"
+              << "Kruskal (chain)     recursive " << recursive_chain / REPETITIONS << " ms, iterative "
+              << iterative_chain / REPETITIONS << " ms\n"
+              << "Concurrent (grid)   1 thread " << concurrent_serial / REPETITIONS << " ms, " << pool.get_size()
+              << " threads " << concurrent_parallel / REPETITIONS << " ms" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -31,12 +31,9 @@ int experiment(std::unique_ptr<CellularAutomata> &ca) {
     while (true) {
         ca->next_generation();
         steps++;
-        if (Solver::is_maze_solvable_bfs(ca->get_graph(), {ca->get_graph()->get_nodes()[0]->get_x(),
-                                                           ca->get_graph()->get_nodes()[0]->get_y()},
-                                         {ca->get_graph()->get_nodes()[
-                                                  ca->get_graph()->get_nodes().size() - 1]->get_x(),
-                                          ca->get_graph()->get_nodes()[
-                                                  ca->get_graph()->get_nodes().size() - 1]->get_y()}))
+        if (Solver::is_maze_solvable_bfs(ca->get_graph(), {ca->get_graph()->get_x(0), ca->get_graph()->get_y(0)},
+                                         {ca->get_graph()->get_x(ca->get_graph()->get_v() - 1),
+                                          ca->get_graph()->get_y(ca->get_graph()->get_v() - 1)}))
             return steps;
         auto end = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
@@ -68,7 +65,9 @@ int main() {
         std::cout << "sqr_size: " << initialize_square_size << std::endl;
         for (int i = 0; i < number_of_experiments; i++) {
             results[initialize_square_size+1][i] = experiment(ca);
-            ca = std::make_unique<CellularAutomata>(rulestring, graph, neighborhood, initialize_square_size);
+            // Every trial has its own seed, so any of them can be run again
+            uint64_t trial = (initialize_square_size + 1) * number_of_experiments + i;
+            ca = std::make_unique<CellularAutomata>(rulestring, graph, neighborhood, initialize_square_size, trial + 1);
         }
     }
 
@@ -0,0 +1,83 @@
+#include <bit>
+#include <cstdlib>
+#include <iostream>
+#include "../maze/generator.h"
+#include "../maze/disjoint_union_sets.h"
+
+/** Window width */
+int WINDOW_WIDTH = 1280;
+/** Window height */
+int WINDOW_HEIGHT = 720;
+/** Window X offset - Maze is drawn on the right square, rest of the screen is GUI on the left */
+int WINDOW_X_OFFSET = WINDOW_WIDTH - WINDOW_HEIGHT;
+/** Grid size for drawing */
+int GRID_SIZE = 50;
+/** Width of the lines representing the paths */
+float WHITE_LINE_WIDTH = (float) GRID_SIZE * 0.5f;
+/** Radius of the nodes (used to make the paths junctions look smooth) */
+float WHITE_NODE_RADIUS = WHITE_LINE_WIDTH / (float) WINDOW_HEIGHT;
+/** Radius of the player */
+float PLAYER_RADIUS = (float) GRID_SIZE * 0.25f / (float) WINDOW_HEIGHT;
+
+/**
+ * Creates a lattice graph
+ * @param type Lattice type
+ * @param width Width of the graph
+ * @param height Height of the graph
+ * @return Graph
+ */
+std::shared_ptr<Graph> create_graph(GraphType type, int width, int height) {
+    if (type == GraphType::ORTHOGONAL)
+        return Generator::create_orthogonal_grid_graph(width, height);
+    if (type == GraphType::HEXAGONAL)
+        return Generator::create_hexagonal_grid_graph(width, height);
+    return Generator::create_orthogonal_grid_graph_laplacian(width, height);
+}
+
+/**
+ * Checks if the maze is perfect (a spanning tree: connected with exactly V - 1 open edges)
+ * @param maze Maze
+ * @param edges Number of open edges of the maze (output)
+ * @return True if the maze is perfect, false otherwise
+ */
+bool is_perfect(const std::shared_ptr<Graph> &maze, int64_t &edges) {
+    Disjoint_union_sets disjoint_union_sets(maze->get_v());
+    int64_t merged = 0;
+    edges = 0;
+    for (int i = 0; i < maze->get_v(); i++)
+        for (unsigned mask = maze->get_open_mask(i); mask; mask &= mask - 1) {
+            auto j = maze->get_topology()->get_neighbor(i, std::countr_zero(mask));
+            if (i >= j) // Every edge only once
+                continue;
+            edges++;
+            merged += disjoint_union_sets.merge(i, j);
+        }
+    return edges == maze->get_v() - 1 && merged == edges;
+}
+
+int main() {
+    constexpr int SEEDS = 4;
+    constexpr std::pair<int, int> SIZES[] = {{64, 65}, {65, 64}, {3, 7}, {7, 3}, {1, 9}, {9, 1}, {33, 2}};
+    constexpr std::pair<float, float> BIASES[] = {{1.0f, 0.0f}, {0.0f, 1.0f}, {0.8f, 0.2f}, {0.2f, 0.8f},
+                                                  {0.0f, 0.0f}};
+    const char *types[] = {"orthogonal", "hexagonal", "laplacian"};
+
+    // Kruskal's algorithm with no cycle bias has to give a perfect maze on every lattice, even at extreme biases
+    auto ok = true;
+    for (auto type: {GraphType::ORTHOGONAL, GraphType::HEXAGONAL, GraphType::LAPLACIAN})
+        for (auto [width, height]: SIZES)
+            for (auto [horizontal_bias, vertical_bias]: BIASES)
+                for (uint64_t seed = 0; seed < SEEDS; seed++) {
+                    auto graph = create_graph(type, width, height);
+                    auto maze = Generator::generate_maze_kruskal(graph, horizontal_bias, vertical_bias, 0.0f, seed);
+                    int64_t edges;
+                    if (is_perfect(maze, edges))
+                        continue;
+                    std::cerr << types[static_cast<int>(type)] << " " << width << "x" << height << ", horizontal bias "
+                              << horizontal_bias << ", vertical bias " << vertical_bias << ", seed " << seed << ": "
+                              << edges << " edges instead of " << maze->get_v() - 1 << " (or not connected)\n";
+                    ok = false;
+                }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -65,59 +65,6 @@ void Drawing::draw_circle(int x, int y, float radius, ImVec4 color) {
     delete[] indices;
 }
 
-void Drawing::buffer_graph(std::shared_ptr<VAO> &vao, std::shared_ptr<VBO> &vbo, std::shared_ptr<EBO> &ebo,
-                           const std::shared_ptr<Graph> &graph, ImVec4 color) {
-    std::vector<float> points;
-
-    for (int i = 0; i < graph->get_v(); i++) {
-        auto node = graph->get_nodes()[i];
-        if (!node->is_alive())
-            continue;
-
-        for (auto j : graph->get_adj()[i]) {
-            auto adjacent_node = graph->get_nodes()[j];
-            if (!adjacent_node->is_alive())
-                continue;
-
-            float x_start, y_start, x_end, y_end;
-            transform_x_y_to_opengl(node->get_x() + WINDOW_X_OFFSET, node->get_y(), x_start, y_start);
-            transform_x_y_to_opengl(adjacent_node->get_x() + WINDOW_X_OFFSET, adjacent_node->get_y(), x_end, y_end);
-
-            points.push_back(x_start);
-            points.push_back(y_start);
-            points.push_back(x_end);
-            points.push_back(y_end);
-        }
-    }
-
-    auto *vertices = new GLfloat[points.size() * 5 / 2]; // 5 floats per vertex
-    for (int i = 0, index = 0; i < points.size(); i += 2, index += 5) {
-        vertices[index] = points[i];
-        vertices[index + 1] = points[i + 1];
-        vertices[index + 2] = color.x;
-        vertices[index + 3] = color.y;
-        vertices[index + 4] = color.z;
-    }
-
-    auto *indices = new GLuint[points.size() / 2]; // 2 vertices per line
-    for (int i = 0; i < points.size() / 2; i++)
-        indices[i] = i; // Index of the vertex
-
-    vao = std::make_shared<VAO>();
-    vao->bind();
-    vbo = std::make_shared<VBO>(vertices, points.size() * 5 / 2 * sizeof(GLfloat));
-    ebo = std::make_shared<EBO>(indices, points.size() / 2 * sizeof(GLuint));
-    vao->link_attribute(vbo, 0, 2, GL_FLOAT, 5 * sizeof(GLfloat), (void *) 0);
-    vao->link_attribute(vbo, 1, 3, GL_FLOAT, 5 * sizeof(GLfloat), (void *) (2 * sizeof(GLfloat)));
-    vao->unbind();
-    vbo->unbind();
-    ebo->unbind();
-
-    // Cleanup
-    delete[] vertices;
-    delete[] indices;
-}
-
 void Drawing::buffer_lines(std::shared_ptr<VAO> &vao, std::shared_ptr<VBO> &vbo, std::shared_ptr<EBO> &ebo,
                            const std::vector<std::pair<int, int>> &lines, ImVec4 color) {
     if (lines.empty())
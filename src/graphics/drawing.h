@@ -39,16 +39,6 @@ public:
      * @param color Color of the circle
      */
     static void draw_circle(int x, int y, float radius, ImVec4 color);
-    /**
-     * Buffer graph paths to VAO, VBO and EBO
-     * @param vao Vertex array object
-     * @param vbo Vertex buffer object
-     * @param ebo Element buffer object
-     * @param graph Maze graph to buffer
-     * @param color Color of the graph
-     */
-    static void buffer_graph(std::shared_ptr<VAO> &vao, std::shared_ptr<VBO> &vbo, std::shared_ptr<EBO> &ebo, const std::shared_ptr<Graph>& graph, ImVec4 color);
-
     /**
      * Buffer lines to VAO, VBO and EBO
      * @param vao Vertex array object
@@ -0,0 +1,156 @@
+#include "graph_buffer.h"
+#include <numeric>
+#include <algorithm>
+#include "drawing.h"
+
+/** Floats of one segment (2 vertices, position and color) */
+constexpr int SEGMENT_FLOATS = 2 * 5;
+
+GraphBuffer::GraphBuffer() : vao(), vbo(), ebo(), color{1.0f, 1.0f, 1.0f, 1.0f}, vertices(), capacity{0},
+                             segment_of_edge(), edge_of_segment() {
+    // Nothing to do here :)
+}
+
+int64_t GraphBuffer::edge_index(const Graph &graph, int src, int slot) {
+    auto &topology = graph.get_topology();
+    auto dest = topology->get_neighbor(src, slot);
+    if (dest < src)
+        return static_cast<int64_t>(dest) * MAX_DEGREE + topology->get_reverse_slot(src, slot);
+    return static_cast<int64_t>(src) * MAX_DEGREE + slot;
+}
+
+void GraphBuffer::add_segment(const Graph &graph, int src, int slot) {
+    auto edge = edge_index(graph, src, slot);
+    if (segment_of_edge[edge] != -1)
+        return;
+
+    auto dest = graph.get_topology()->get_neighbor(src, slot);
+    float x_start, y_start, x_end, y_end;
+    Drawing::transform_x_y_to_opengl(graph.get_x(src) + WINDOW_X_OFFSET, graph.get_y(src), x_start, y_start);
+    Drawing::transform_x_y_to_opengl(graph.get_x(dest) + WINDOW_X_OFFSET, graph.get_y(dest), x_end, y_end);
+    auto segment = static_cast<int>(edge_of_segment.size());
+    vertices.insert(vertices.end(), {x_start, y_start, color.x, color.y, color.z,
+                                     x_end, y_end, color.x, color.y, color.z});
+    segment_of_edge[edge] = segment;
+    edge_of_segment.push_back(edge);
+
+    if (!vbo) // Buffered later at once
+        return;
+    if (segment >= capacity) { // Full, the buffers grow geometrically (amortized O(1) per segment)
+        capacity *= 2;
+        upload();
+        return;
+    }
+    vbo->update(static_cast<GLintptr>(segment) * SEGMENT_FLOATS * sizeof(GLfloat),
+                vertices.data() + segment * SEGMENT_FLOATS, SEGMENT_FLOATS * sizeof(GLfloat));
+    ebo->num_elements = 2 * (segment + 1);
+}
+
+void GraphBuffer::remove_segment(int64_t edge) {
+    auto segment = segment_of_edge[edge];
+    if (segment == -1)
+        return;
+
+    // The last segment fills the gap, so the drawn segments stay packed
+    auto last = static_cast<int>(edge_of_segment.size()) - 1;
+    if (segment != last) {
+        std::copy_n(vertices.begin() + last * SEGMENT_FLOATS, SEGMENT_FLOATS,
+                    vertices.begin() + segment * SEGMENT_FLOATS);
+        edge_of_segment[segment] = edge_of_segment[last];
+        segment_of_edge[edge_of_segment[segment]] = segment;
+        if (vbo)
+            vbo->update(static_cast<GLintptr>(segment) * SEGMENT_FLOATS * sizeof(GLfloat),
+                        vertices.data() + segment * SEGMENT_FLOATS, SEGMENT_FLOATS * sizeof(GLfloat));
+    }
+    segment_of_edge[edge] = -1;
+    edge_of_segment.pop_back();
+    vertices.resize(vertices.size() - SEGMENT_FLOATS);
+    if (ebo)
+        ebo->num_elements = 2 * last;
+}
+
+void GraphBuffer::upload() {
+    del();
+
+    // Indices of all segments are fixed, the number of drawn elements selects the used ones
+    std::vector<GLuint> indices(2 * capacity);
+    std::iota(indices.begin(), indices.end(), 0);
+
+    vao = std::make_shared<VAO>();
+    vao->bind();
+    vbo = std::make_shared<VBO>(nullptr, capacity * SEGMENT_FLOATS * sizeof(GLfloat), GL_DYNAMIC_DRAW);
+    vbo->update(0, vertices.data(), static_cast<GLsizeiptr>(vertices.size() * sizeof(GLfloat)));
+    ebo = std::make_shared<EBO>(indices.data(), indices.size() * sizeof(GLuint));
+    ebo->num_elements = static_cast<GLsizei>(2 * edge_of_segment.size());
+    vao->link_attribute(vbo, 0, 2, GL_FLOAT, 5 * sizeof(GLfloat), (void *) 0);
+    vao->link_attribute(vbo, 1, 3, GL_FLOAT, 5 * sizeof(GLfloat), (void *) (2 * sizeof(GLfloat)));
+    vao->unbind();
+    vbo->unbind();
+    ebo->unbind();
+}
+
+void GraphBuffer::buffer_graph(const std::shared_ptr<Graph> &graph, ImVec4 new_color) {
+    del();
+    color = new_color;
+    vertices.clear();
+    edge_of_segment.clear();
+    segment_of_edge.assign(static_cast<size_t>(graph->get_v()) * MAX_DEGREE, -1);
+
+    for (int i = 0; i < graph->get_v(); i++) {
+        if (!graph->is_alive(i))
+            continue;
+        for (unsigned mask = graph->get_open_mask(i); mask; mask &= mask - 1) {
+            auto slot = std::countr_zero(mask);
+            if (graph->is_alive(graph->get_topology()->get_neighbor(i, slot)))
+                add_segment(*graph, i, slot);
+        }
+    }
+
+    // Room for some growth, so the first generations do not resize the buffers
+    capacity = static_cast<int>(edge_of_segment.size()) + static_cast<int>(edge_of_segment.size()) / 2 + 64;
+    upload();
+}
+
+void GraphBuffer::update_graph(const std::shared_ptr<Graph> &graph, const GenerationDelta &delta) {
+    // Nothing buffered for this graph yet
+    if (segment_of_edge.size() != static_cast<size_t>(graph->get_v()) * MAX_DEGREE) {
+        buffer_graph(graph, color);
+        return;
+    }
+
+    auto &topology = graph->get_topology();
+    for (auto &[src, dest]: delta.closed) {
+        auto slot = topology->find_slot(src, dest);
+        if (slot != -1)
+            remove_segment(edge_index(*graph, src, slot));
+    }
+
+    // Dead nodes have no drawn paths (their edges are closed by the delta as well, this only guards the invariant)
+    for (auto i: delta.died)
+        for (unsigned mask = topology->get_slot_mask(i); mask; mask &= mask - 1)
+            remove_segment(edge_index(*graph, i, std::countr_zero(mask)));
+
+    for (auto &[src, dest]: delta.opened) {
+        auto slot = topology->find_slot(src, dest);
+        if (slot != -1 && graph->is_alive(src) && graph->is_alive(dest))
+            add_segment(*graph, src, slot);
+    }
+}
+
+void GraphBuffer::draw() const {
+    if (!vao)
+        return;
+
+    vao->bind();
+    glDrawElements(GL_LINES, ebo->num_elements, GL_UNSIGNED_INT, 0);
+    vao->unbind();
+}
+
+void GraphBuffer::del() {
+    if (vao) vao->del();
+    if (vbo) vbo->del();
+    if (ebo) ebo->del();
+    vao = nullptr;
+    vbo = nullptr;
+    ebo = nullptr;
+}
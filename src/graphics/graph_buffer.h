@@ -0,0 +1,96 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "GL/glew.h"
+#include "GLFW/glfw3.h"
+#include "../maze/graph.h"
+#include "../maze/generation_delta.h"
+#include "shaders/VAO.h"
+#include "shaders/VBO.h"
+#include "shaders/EBO.h"
+#include "imgui.h"
+
+/**
+ * Buffered paths of a maze graph (one line segment per open edge between alive nodes)
+ * The segments are packed at the start of the VBO, so a generation of a cellular automata
+ * only rewrites the segments of its delta instead of buffering the whole graph again
+ */
+class GraphBuffer {
+private:
+    /** Vertex array object */
+    std::shared_ptr<VAO> vao;
+    /** Vertex buffer object (room for capacity segments, the first segments are drawn) */
+    std::shared_ptr<VBO> vbo;
+    /** Element buffer object (indices of all capacity segments, only the used ones are drawn) */
+    std::shared_ptr<EBO> ebo;
+    /** Color of the paths */
+    ImVec4 color;
+    /** Vertices of the drawn segments (copy of the used part of the VBO, 2 vertices of 5 floats per segment) */
+    std::vector<GLfloat> vertices;
+    /** Number of segments the VBO has room for */
+    int capacity;
+    /** Segment of every edge (indexed by the smaller node * MAX_DEGREE + slot of the edge there, -1 if not drawn) */
+    std::vector<int> segment_of_edge;
+    /** Edge of every drawn segment (same index as segment_of_edge) */
+    std::vector<int64_t> edge_of_segment;
+
+    /**
+     * Computes the index of an edge
+     * @param graph Graph of the edge
+     * @param src Node index
+     * @param slot Slot of the edge at the node
+     * @return Index of the edge seen from its smaller node
+     */
+    [[nodiscard]] static int64_t edge_index(const Graph &graph, int src, int slot);
+
+    /**
+     * Appends the segment of an edge (the VBO grows if it is full)
+     * @param graph Graph of the edge
+     * @param src Node index
+     * @param slot Slot of the edge at the node
+     */
+    void add_segment(const Graph &graph, int src, int slot);
+
+    /**
+     * Removes the segment of an edge, the last segment moves into its place
+     * @param edge Index of the edge (nothing happens if it is not drawn)
+     */
+    void remove_segment(int64_t edge);
+
+    /**
+     * Creates the buffers with room for capacity segments and copies the drawn segments into them
+     */
+    void upload();
+
+public:
+    /**
+     * Constructor of an empty buffer
+     */
+    GraphBuffer();
+
+    /**
+     * Buffers the whole graph (after the graph was loaded, generated or reset)
+     * @param graph Maze graph to buffer
+     * @param new_color Color of the paths
+     */
+    void buffer_graph(const std::shared_ptr<Graph> &graph, ImVec4 new_color);
+
+    /**
+     * Rewrites only the segments of the changed edges and nodes, O(size of the delta)
+     * @param graph Maze graph after the change (same topology as the buffered one)
+     * @param delta Changes of the graph since it was buffered
+     */
+    void update_graph(const std::shared_ptr<Graph> &graph, const GenerationDelta &delta);
+
+    /**
+     * Draws the paths (nothing if nothing was buffered)
+     */
+    void draw() const;
+
+    /**
+     * Deletes the buffers
+     */
+    void del();
+};
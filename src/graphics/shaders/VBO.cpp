@@ -1,9 +1,14 @@
 #include "VBO.h"
 
-VBO::VBO(GLfloat *vertices, GLsizeiptr size) {
+VBO::VBO(GLfloat *vertices, GLsizeiptr size, GLenum usage) {
     glGenBuffers(1, &id);
     glBindBuffer(GL_ARRAY_BUFFER, id);
-    glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, size, vertices, usage);
+}
+
+void VBO::update(GLintptr offset, const GLfloat *vertices, GLsizeiptr size) const {
+    glBindBuffer(GL_ARRAY_BUFFER, id);
+    glBufferSubData(GL_ARRAY_BUFFER, offset, size, vertices);
 }
 
 void VBO::bind() const {
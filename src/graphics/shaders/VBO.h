@@ -14,8 +14,17 @@ public:
      * Constructor
      * @param vertices Array of vertices
      * @param size Size of the array
+     * @param usage Usage hint (GL_DYNAMIC_DRAW for buffers updated in place)
      */
-    VBO(GLfloat *vertices, GLsizeiptr size);
+    VBO(GLfloat *vertices, GLsizeiptr size, GLenum usage = GL_STATIC_DRAW);
+
+    /**
+     * Overwrites a part of the VBO
+     * @param offset Offset in the VBO in bytes
+     * @param vertices Array of vertices
+     * @param size Size of the array
+     */
+    void update(GLintptr offset, const GLfloat *vertices, GLsizeiptr size) const;
 
     /**
      * Bind the VBO
@@ -1,6 +1,5 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
-#include <regex>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb_image_write.h"
 #include "imgui.h"
@@ -12,9 +11,11 @@
 #include "graphics/shaders/VBO.h"
 #include "graphics/shaders/EBO.h"
 #include "graphics/drawing.h"
+#include "graphics/graph_buffer.h"
 #include "maze/generator.h"
 #include "maze/solver.h"
 #include "maze/cellular_automata.h"
+#include "maze/maze_file.h"
 #include "player.h"
 #include "imgui_internal.h"
 
@@ -79,13 +80,19 @@ std::vector<std::pair<int, int>> solved_path_from_player;
 
 /** String of Rules for the Cellular Automata (example: Game of Life uses B3/S23) */
 std::string rulestring = "B3/S1234";
-/** Regular Expression to check the format of the input String of Rules */
-std::regex rulestring_regex("B([0-9]+)/S([0-9]+)");
 /** Speed of the evolution of the Cellular Automata */
 float speed = 0.6f;
 /** Size of the square that is initialized in the Cellular Automata (counted from the top left corner - start) */
 int initialize_square_size = -1;
 
+/** Name of the file the maze is saved to and loaded from */
+std::string maze_filename = "maze.bin";
+
+/** Seed of the generated maze (the same seed and settings always generate the same maze) */
+uint64_t seed = 0;
+/** Choose a new seed on every generation */
+bool random_seed = true;
+
 /** Horizontal bias for the Kruskal algorithm */
 float horizontal_bias = 0.5f;
 /** Vertical bias for the Kruskal algorithm */
@@ -139,12 +146,11 @@ std::shared_ptr<VBO> background_vbo;
 /** Background Element Buffer Object */
 std::shared_ptr<EBO> background_ebo;
 
-/** Paths Vertex Array Object */
-std::shared_ptr<VAO> paths_vao;
-/** Paths Vertex Buffer Object */
-std::shared_ptr<VBO> paths_vbo;
-/** Paths Element Buffer Object */
-std::shared_ptr<EBO> paths_ebo;
+/** Paths of the maze (updated by the deltas of the Cellular Automata) */
+GraphBuffer paths_buffer;
+
+/** Workers checking the connectivity of the Cellular Automata after every generation (started once) */
+ThreadPool solver_pool;
 
 /** Solution Vertex Array Object */
 std::shared_ptr<VAO> solution_vao;
@@ -210,7 +216,7 @@ void cursor_position_callback(GLFWwindow *window, double xpos, double ypos) {
 
         // If the player is adjacent to the mouse, move the player
         if (maze->is_adjacent(nearest_to_player, nearest_to_mouse)) {
-            player->move_to(maze->get_nodes()[nearest_to_mouse]->get_x(), maze->get_nodes()[nearest_to_mouse]->get_y());
+            player->move_to(maze->get_x(nearest_to_mouse), maze->get_y(nearest_to_mouse));
             moved = true; // The player moved
         }
     }
@@ -221,9 +227,9 @@ void cursor_position_callback(GLFWwindow *window, double xpos, double ypos) {
 
         // If the player is adjacent to the mouse, move the player
         if (ca->get_graph()->is_adjacent(nearest_to_player, nearest_to_mouse) &&
-            ca->get_graph()->get_nodes()[nearest_to_mouse]->is_alive()) {
-            player->move_to(ca->get_graph()->get_nodes()[nearest_to_mouse]->get_x(),
-                            ca->get_graph()->get_nodes()[nearest_to_mouse]->get_y());
+            ca->get_graph()->is_alive(nearest_to_mouse)) {
+            player->move_to(ca->get_graph()->get_x(nearest_to_mouse),
+                            ca->get_graph()->get_y(nearest_to_mouse));
             moved = true; // The player moved
         }
     }
@@ -234,96 +240,62 @@ void cursor_position_callback(GLFWwindow *window, double xpos, double ypos) {
 
     // Check if the player has reached the end
     if (maze_type == MazeType::STATIC)
-        is_solved = is_solved || (player->get_x() == maze->get_nodes()[maze->get_v() - 1]->get_x() &&
-                                  player->get_y() == maze->get_nodes()[maze->get_v() - 1]->get_y());
+        is_solved = is_solved || (player->get_x() == maze->get_x(maze->get_v() - 1) &&
+                                  player->get_y() == maze->get_y(maze->get_v() - 1));
     else if (maze_type == MazeType::DYNAMIC)
         is_solved =
-                is_solved || (player->get_x() == ca->get_graph()->get_nodes()[ca->get_graph()->get_v() - 1]->get_x() &&
-                              player->get_y() == ca->get_graph()->get_nodes()[ca->get_graph()->get_v() - 1]->get_y());
+                is_solved || (player->get_x() == ca->get_graph()->get_x(ca->get_graph()->get_v() - 1) &&
+                              player->get_y() == ca->get_graph()->get_y(ca->get_graph()->get_v() - 1));
 
     // Check the solution from the player's position
     if (maze_type == MazeType::STATIC) {
         if (solver_algorithm == SolverType::BREATH_FIRST_SEARCH) {
             is_solvable_from_player = Solver::is_maze_solvable_bfs(maze, {player->get_x(), player->get_y()},
-                                                                   {maze->get_nodes()[maze->get_nodes().size() -
-                                                                                      1]->get_x(),
-                                                                    maze->get_nodes()[maze->get_nodes().size() -
-                                                                                      1]->get_y()});
+                                                                   {maze->get_x(maze->get_v() - 1),
+                                                                    maze->get_y(maze->get_v() - 1)});
             solved_path_from_player = Solver::solve_maze_bfs(maze, {player->get_x(), player->get_y()},
-                                                             {maze->get_nodes()[maze->get_nodes().size() - 1]->get_x(),
-                                                              maze->get_nodes()[maze->get_nodes().size() -
-                                                                                1]->get_y()});
+                                                             {maze->get_x(maze->get_v() - 1),
+                                                              maze->get_y(maze->get_v() - 1)});
         } else if (solver_algorithm == SolverType::DIJKSTRA) {
             is_solvable_from_player = Solver::is_maze_solvable_dijkstra(maze, {player->get_x(), player->get_y()},
-                                                                        {maze->get_nodes()[maze->get_nodes().size() -
-                                                                                           1]->get_x(),
-                                                                         maze->get_nodes()[maze->get_nodes().size() -
-                                                                                           1]->get_y()});
+                                                                        {maze->get_x(maze->get_v() - 1),
+                                                                         maze->get_y(maze->get_v() - 1)});
             solved_path_from_player = Solver::solve_maze_dijkstra(maze, {player->get_x(), player->get_y()},
-                                                                  {maze->get_nodes()[maze->get_nodes().size() -
-                                                                                     1]->get_x(),
-                                                                   maze->get_nodes()[maze->get_nodes().size() -
-                                                                                     1]->get_y()});
+                                                                  {maze->get_x(maze->get_v() - 1),
+                                                                   maze->get_y(maze->get_v() - 1)});
         } else if (solver_algorithm == SolverType::A_STAR) {
             is_solvable_from_player = Solver::is_maze_solvable_a_star(maze, {player->get_x(), player->get_y()},
-                                                                      {maze->get_nodes()[maze->get_nodes().size() -
-                                                                                         1]->get_x(),
-                                                                       maze->get_nodes()[maze->get_nodes().size() -
-                                                                                         1]->get_y()}, heuristic);
+                                                                      {maze->get_x(maze->get_v() - 1),
+                                                                       maze->get_y(maze->get_v() - 1)}, heuristic);
             solved_path_from_player = Solver::solve_maze_a_star(maze, {player->get_x(), player->get_y()},
-                                                                {maze->get_nodes()[maze->get_nodes().size() -
-                                                                                   1]->get_x(),
-                                                                 maze->get_nodes()[maze->get_nodes().size() -
-                                                                                   1]->get_y()}, heuristic);
+                                                                {maze->get_x(maze->get_v() - 1),
+                                                                 maze->get_y(maze->get_v() - 1)}, heuristic);
         }
     }
     if (maze_type == MazeType::DYNAMIC) {
         if (solver_algorithm == SolverType::BREATH_FIRST_SEARCH) {
             is_solvable_from_player = Solver::is_maze_solvable_bfs(ca->get_graph(), {player->get_x(), player->get_y()},
-                                                                   {ca->get_graph()->get_nodes()[
-                                                                            ca->get_graph()->get_nodes().size() -
-                                                                            1]->get_x(),
-                                                                    ca->get_graph()->get_nodes()[
-                                                                            ca->get_graph()->get_nodes().size() -
-                                                                            1]->get_y()});
+                                                                   {ca->get_graph()->get_x(ca->get_graph()->get_v() - 1),
+                                                                    ca->get_graph()->get_y(ca->get_graph()->get_v() - 1)});
             solved_path_from_player = Solver::solve_maze_bfs(ca->get_graph(), {player->get_x(), player->get_y()},
-                                                             {ca->get_graph()->get_nodes()[
-                                                                      ca->get_graph()->get_nodes().size() - 1]->get_x(),
-                                                              ca->get_graph()->get_nodes()[
-                                                                      ca->get_graph()->get_nodes().size() -
-                                                                      1]->get_y()});
+                                                             {ca->get_graph()->get_x(ca->get_graph()->get_v() - 1),
+                                                              ca->get_graph()->get_y(ca->get_graph()->get_v() - 1)});
         } else if (solver_algorithm == SolverType::DIJKSTRA) {
             is_solvable_from_player = Solver::is_maze_solvable_dijkstra(ca->get_graph(),
                                                                         {player->get_x(), player->get_y()},
-                                                                        {ca->get_graph()->get_nodes()[
-                                                                                 ca->get_graph()->get_nodes().size() -
-                                                                                 1]->get_x(),
-                                                                         ca->get_graph()->get_nodes()[
-                                                                                 ca->get_graph()->get_nodes().size() -
-                                                                                 1]->get_y()});
+                                                                        {ca->get_graph()->get_x(ca->get_graph()->get_v() - 1),
+                                                                         ca->get_graph()->get_y(ca->get_graph()->get_v() - 1)});
             solved_path_from_player = Solver::solve_maze_dijkstra(ca->get_graph(), {player->get_x(), player->get_y()},
-                                                                  {ca->get_graph()->get_nodes()[
-                                                                           ca->get_graph()->get_nodes().size() -
-                                                                           1]->get_x(),
-                                                                   ca->get_graph()->get_nodes()[
-                                                                           ca->get_graph()->get_nodes().size() -
-                                                                           1]->get_y()});
+                                                                  {ca->get_graph()->get_x(ca->get_graph()->get_v() - 1),
+                                                                   ca->get_graph()->get_y(ca->get_graph()->get_v() - 1)});
         } else if (solver_algorithm == SolverType::A_STAR) {
             is_solvable_from_player = Solver::is_maze_solvable_a_star(ca->get_graph(),
                                                                       {player->get_x(), player->get_y()},
-                                                                      {ca->get_graph()->get_nodes()[
-                                                                               ca->get_graph()->get_nodes().size() -
-                                                                               1]->get_x(),
-                                                                       ca->get_graph()->get_nodes()[
-                                                                               ca->get_graph()->get_nodes().size() -
-                                                                               1]->get_y()}, heuristic);
+                                                                      {ca->get_graph()->get_x(ca->get_graph()->get_v() - 1),
+                                                                       ca->get_graph()->get_y(ca->get_graph()->get_v() - 1)}, heuristic);
             solved_path_from_player = Solver::solve_maze_a_star(ca->get_graph(), {player->get_x(), player->get_y()},
-                                                                {ca->get_graph()->get_nodes()[
-                                                                         ca->get_graph()->get_nodes().size() -
-                                                                         1]->get_x(),
-                                                                 ca->get_graph()->get_nodes()[
-                                                                         ca->get_graph()->get_nodes().size() -
-                                                                         1]->get_y()}, heuristic);
+                                                                {ca->get_graph()->get_x(ca->get_graph()->get_v() - 1),
+                                                                 ca->get_graph()->get_y(ca->get_graph()->get_v() - 1)}, heuristic);
         }
     }
 
@@ -385,18 +357,17 @@ void export_as_image_raw_maze_callback(GLFWwindow *window) {
     // Draw maze
     if (draw) {
         glLineWidth(WHITE_LINE_WIDTH);
-        paths_vao->bind();
-        glDrawElements(GL_LINES, paths_ebo->num_elements, GL_UNSIGNED_INT, 0);
-        paths_vao->unbind();
+        paths_buffer.draw();
 
         // Draw the nodes as circles to smooth the lines conjunctions
         if (maze_type == MazeType::STATIC) {
-            for (auto &node: maze->get_nodes())
-                Drawing::draw_circle(node->get_x(), node->get_y(), WHITE_NODE_RADIUS, paths_color);
+            for (int i = 0; i < maze->get_v(); i++)
+                Drawing::draw_circle(maze->get_x(i), maze->get_y(i), WHITE_NODE_RADIUS, paths_color);
         } else if (maze_type == MazeType::DYNAMIC) {
-            for (auto &node: ca->get_graph()->get_nodes())
-                if (node->is_alive()) // Draw alive nodes only
-                    Drawing::draw_circle(node->get_x(), node->get_y(), WHITE_NODE_RADIUS, paths_color);
+            for (int i = 0; i < ca->get_graph()->get_v(); i++)
+                if (ca->get_graph()->is_alive(i)) // Draw alive nodes only
+                    Drawing::draw_circle(ca->get_graph()->get_x(i), ca->get_graph()->get_y(i), WHITE_NODE_RADIUS,
+                                         paths_color);
         }
     }
 
@@ -480,167 +451,89 @@ void solve_button_callback() {
     if (maze_type == MazeType::STATIC && maze) {
         if (solver_algorithm == SolverType::BREATH_FIRST_SEARCH) {
             is_solvable = Solver::is_maze_solvable_bfs(maze,
-                                                       {maze->get_nodes()[0]->get_x(), maze->get_nodes()[0]->get_y()},
-                                                       {maze->get_nodes()[maze->get_nodes().size() - 1]->get_x(),
-                                                        maze->get_nodes()[maze->get_nodes().size() - 1]->get_y()});
+                                                       {maze->get_x(0), maze->get_y(0)},
+                                                       {maze->get_x(maze->get_v() - 1),
+                                                        maze->get_y(maze->get_v() - 1)});
 
-            solved_path = Solver::solve_maze_bfs(maze, {maze->get_nodes()[0]->get_x(), maze->get_nodes()[0]->get_y()},
-                                                 {maze->get_nodes()[maze->get_nodes().size() - 1]->get_x(),
-                                                  maze->get_nodes()[maze->get_nodes().size() - 1]->get_y()});
+            solved_path = Solver::solve_maze_bfs(maze, {maze->get_x(0), maze->get_y(0)},
+                                                 {maze->get_x(maze->get_v() - 1),
+                                                  maze->get_y(maze->get_v() - 1)});
 
             is_solvable_from_player = Solver::is_maze_solvable_bfs(maze, {player->get_x(), player->get_y()},
-                                                                   {maze->get_nodes()[maze->get_nodes().size() -
-                                                                                      1]->get_x(),
-                                                                    maze->get_nodes()[maze->get_nodes().size() -
-                                                                                      1]->get_y()});
+                                                                   {maze->get_x(maze->get_v() - 1),
+                                                                    maze->get_y(maze->get_v() - 1)});
 
             solved_path_from_player = Solver::solve_maze_bfs(maze, {player->get_x(), player->get_y()},
-                                                             {maze->get_nodes()[maze->get_nodes().size() - 1]->get_x(),
-                                                              maze->get_nodes()[maze->get_nodes().size() -
-                                                                                1]->get_y()});
+                                                             {maze->get_x(maze->get_v() - 1),
+                                                              maze->get_y(maze->get_v() - 1)});
         } else if (solver_algorithm == SolverType::DIJKSTRA) {
-            is_solvable = Solver::is_maze_solvable_dijkstra(maze, {maze->get_nodes()[0]->get_x(),
-                                                                   maze->get_nodes()[0]->get_y()},
-                                                            {maze->get_nodes()[maze->get_nodes().size() - 1]->get_x(),
-                                                             maze->get_nodes()[maze->get_nodes().size() - 1]->get_y()});
+            is_solvable = Solver::is_maze_solvable_dijkstra(maze, {maze->get_x(0),
+                                                                   maze->get_y(0)},
+                                                            {maze->get_x(maze->get_v() - 1),
+                                                             maze->get_y(maze->get_v() - 1)});
 
             solved_path = Solver::solve_maze_dijkstra(maze,
-                                                      {maze->get_nodes()[0]->get_x(), maze->get_nodes()[0]->get_y()},
-                                                      {maze->get_nodes()[maze->get_nodes().size() - 1]->get_x(),
-                                                       maze->get_nodes()[maze->get_nodes().size() - 1]->get_y()});
+                                                      {maze->get_x(0), maze->get_y(0)},
+                                                      {maze->get_x(maze->get_v() - 1),
+                                                       maze->get_y(maze->get_v() - 1)});
 
             is_solvable_from_player = Solver::is_maze_solvable_dijkstra(maze, {player->get_x(), player->get_y()},
-                                                                        {maze->get_nodes()[maze->get_nodes().size() -
-                                                                                           1]->get_x(),
-                                                                         maze->get_nodes()[maze->get_nodes().size() -
-                                                                                           1]->get_y()});
+                                                                        {maze->get_x(maze->get_v() - 1),
+                                                                         maze->get_y(maze->get_v() - 1)});
 
             solved_path_from_player = Solver::solve_maze_dijkstra(maze, {player->get_x(), player->get_y()},
-                                                                  {maze->get_nodes()[maze->get_nodes().size() -
-                                                                                     1]->get_x(),
-                                                                   maze->get_nodes()[maze->get_nodes().size() -
-                                                                                     1]->get_y()});
+                                                                  {maze->get_x(maze->get_v() - 1),
+                                                                   maze->get_y(maze->get_v() - 1)});
         } else if (solver_algorithm == SolverType::A_STAR) {
-            is_solvable = Solver::is_maze_solvable_a_star(maze, {maze->get_nodes()[0]->get_x(),
-                                                                 maze->get_nodes()[0]->get_y()},
-                                                          {maze->get_nodes()[maze->get_nodes().size() - 1]->get_x(),
-                                                           maze->get_nodes()[maze->get_nodes().size() - 1]->get_y()},
+            is_solvable = Solver::is_maze_solvable_a_star(maze, {maze->get_x(0),
+                                                                 maze->get_y(0)},
+                                                          {maze->get_x(maze->get_v() - 1),
+                                                           maze->get_y(maze->get_v() - 1)},
                                                           heuristic);
 
             solved_path = Solver::solve_maze_a_star(maze,
-                                                    {maze->get_nodes()[0]->get_x(), maze->get_nodes()[0]->get_y()},
-                                                    {maze->get_nodes()[maze->get_nodes().size() - 1]->get_x(),
-                                                     maze->get_nodes()[maze->get_nodes().size() - 1]->get_y()},
+                                                    {maze->get_x(0), maze->get_y(0)},
+                                                    {maze->get_x(maze->get_v() - 1),
+                                                     maze->get_y(maze->get_v() - 1)},
                                                     heuristic);
 
             is_solvable_from_player = Solver::is_maze_solvable_a_star(maze, {player->get_x(), player->get_y()},
-                                                                      {maze->get_nodes()[maze->get_nodes().size() -
-                                                                                         1]->get_x(),
-                                                                       maze->get_nodes()[maze->get_nodes().size() -
-                                                                                         1]->get_y()}, heuristic);
+                                                                      {maze->get_x(maze->get_v() - 1),
+                                                                       maze->get_y(maze->get_v() - 1)}, heuristic);
 
             solved_path_from_player = Solver::solve_maze_a_star(maze, {player->get_x(), player->get_y()},
-                                                                {maze->get_nodes()[maze->get_nodes().size() -
-                                                                                   1]->get_x(),
-                                                                 maze->get_nodes()[maze->get_nodes().size() -
-                                                                                   1]->get_y()}, heuristic);
+                                                                {maze->get_x(maze->get_v() - 1),
+                                                                 maze->get_y(maze->get_v() - 1)}, heuristic);
         }
     }
         // Dynamic maze
     else if (maze_type == MazeType::DYNAMIC && ca) {
-        if (solver_algorithm == SolverType::BREATH_FIRST_SEARCH) {
-            is_solvable = Solver::is_maze_solvable_bfs(ca->get_graph(), {ca->get_graph()->get_nodes()[0]->get_x(),
-                                                                         ca->get_graph()->get_nodes()[0]->get_y()},
-                                                       {ca->get_graph()->get_nodes()[
-                                                                ca->get_graph()->get_nodes().size() - 1]->get_x(),
-                                                        ca->get_graph()->get_nodes()[
-                                                                ca->get_graph()->get_nodes().size() - 1]->get_y()});
-
-            solved_path = Solver::solve_maze_bfs(ca->get_graph(), {ca->get_graph()->get_nodes()[0]->get_x(),
-                                                                   ca->get_graph()->get_nodes()[0]->get_y()},
-                                                 {ca->get_graph()->get_nodes()[ca->get_graph()->get_nodes().size() -
-                                                                               1]->get_x(),
-                                                  ca->get_graph()->get_nodes()[ca->get_graph()->get_nodes().size() -
-                                                                               1]->get_y()});
+        auto &graph = ca->get_graph();
+        std::pair<int, int> start = {graph->get_x(0), graph->get_y(0)};
+        std::pair<int, int> player_position = {player->get_x(), player->get_y()};
+        std::pair<int, int> end = {graph->get_x(graph->get_v() - 1), graph->get_y(graph->get_v() - 1)};
 
-            is_solvable_from_player = Solver::is_maze_solvable_bfs(ca->get_graph(), {player->get_x(), player->get_y()},
-                                                                   {ca->get_graph()->get_nodes()[
-                                                                            ca->get_graph()->get_nodes().size() -
-                                                                            1]->get_x(),
-                                                                    ca->get_graph()->get_nodes()[
-                                                                            ca->get_graph()->get_nodes().size() -
-                                                                            1]->get_y()});
+        // Connectivity of the generation on the workers, the paths are only searched if they exist
+        is_solvable = Solver::is_maze_solvable_union_find(graph, start, end, solver_pool);
+        is_solvable_from_player = Solver::is_maze_solvable_union_find(graph, player_position, end, solver_pool);
+        solved_path.clear();
+        solved_path_from_player.clear();
 
-            solved_path_from_player = Solver::solve_maze_bfs(ca->get_graph(), {player->get_x(), player->get_y()},
-                                                             {ca->get_graph()->get_nodes()[
-                                                                      ca->get_graph()->get_nodes().size() - 1]->get_x(),
-                                                              ca->get_graph()->get_nodes()[
-                                                                      ca->get_graph()->get_nodes().size() -
-                                                                      1]->get_y()});
+        if (solver_algorithm == SolverType::BREATH_FIRST_SEARCH) {
+            if (is_solvable)
+                solved_path = Solver::solve_maze_bfs(graph, start, end);
+            if (is_solvable_from_player)
+                solved_path_from_player = Solver::solve_maze_bfs(graph, player_position, end);
         } else if (solver_algorithm == SolverType::DIJKSTRA) {
-            is_solvable = Solver::is_maze_solvable_dijkstra(ca->get_graph(), {ca->get_graph()->get_nodes()[0]->get_x(),
-                                                                              ca->get_graph()->get_nodes()[0]->get_y()},
-                                                            {ca->get_graph()->get_nodes()[
-                                                                     ca->get_graph()->get_nodes().size() - 1]->get_x(),
-                                                             ca->get_graph()->get_nodes()[
-                                                                     ca->get_graph()->get_nodes().size() -
-                                                                     1]->get_y()});
-
-            solved_path = Solver::solve_maze_dijkstra(ca->get_graph(), {ca->get_graph()->get_nodes()[0]->get_x(),
-                                                                        ca->get_graph()->get_nodes()[0]->get_y()},
-                                                      {ca->get_graph()->get_nodes()[
-                                                               ca->get_graph()->get_nodes().size() - 1]->get_x(),
-                                                       ca->get_graph()->get_nodes()[
-                                                               ca->get_graph()->get_nodes().size() - 1]->get_y()});
-
-            is_solvable_from_player = Solver::is_maze_solvable_dijkstra(ca->get_graph(),
-                                                                        {player->get_x(), player->get_y()},
-                                                                        {ca->get_graph()->get_nodes()[
-                                                                                 ca->get_graph()->get_nodes().size() -
-                                                                                 1]->get_x(),
-                                                                         ca->get_graph()->get_nodes()[
-                                                                                 ca->get_graph()->get_nodes().size() -
-                                                                                 1]->get_y()});
-
-            solved_path_from_player = Solver::solve_maze_dijkstra(ca->get_graph(), {player->get_x(), player->get_y()},
-                                                                  {ca->get_graph()->get_nodes()[
-                                                                           ca->get_graph()->get_nodes().size() -
-                                                                           1]->get_x(),
-                                                                   ca->get_graph()->get_nodes()[
-                                                                           ca->get_graph()->get_nodes().size() -
-                                                                           1]->get_y()});
+            if (is_solvable)
+                solved_path = Solver::solve_maze_dijkstra(graph, start, end);
+            if (is_solvable_from_player)
+                solved_path_from_player = Solver::solve_maze_dijkstra(graph, player_position, end);
         } else if (solver_algorithm == SolverType::A_STAR) {
-            is_solvable = Solver::is_maze_solvable_a_star(ca->get_graph(), {ca->get_graph()->get_nodes()[0]->get_x(),
-                                                                            ca->get_graph()->get_nodes()[0]->get_y()},
-                                                          {ca->get_graph()->get_nodes()[
-                                                                   ca->get_graph()->get_nodes().size() - 1]->get_x(),
-                                                           ca->get_graph()->get_nodes()[
-                                                                   ca->get_graph()->get_nodes().size() - 1]->get_y()},
-                                                          heuristic);
-
-            solved_path = Solver::solve_maze_a_star(ca->get_graph(), {ca->get_graph()->get_nodes()[0]->get_x(),
-                                                                      ca->get_graph()->get_nodes()[0]->get_y()},
-                                                    {ca->get_graph()->get_nodes()[ca->get_graph()->get_nodes().size() -
-                                                                                  1]->get_x(),
-                                                     ca->get_graph()->get_nodes()[ca->get_graph()->get_nodes().size() -
-                                                                                  1]->get_y()}, heuristic);
-
-            is_solvable_from_player = Solver::is_maze_solvable_a_star(ca->get_graph(),
-                                                                      {player->get_x(), player->get_y()},
-                                                                      {ca->get_graph()->get_nodes()[
-                                                                               ca->get_graph()->get_nodes().size() -
-                                                                               1]->get_x(),
-                                                                       ca->get_graph()->get_nodes()[
-                                                                               ca->get_graph()->get_nodes().size() -
-                                                                               1]->get_y()}, heuristic);
-
-            solved_path_from_player = Solver::solve_maze_a_star(ca->get_graph(), {player->get_x(), player->get_y()},
-                                                                {ca->get_graph()->get_nodes()[
-                                                                         ca->get_graph()->get_nodes().size() -
-                                                                         1]->get_x(),
-                                                                 ca->get_graph()->get_nodes()[
-                                                                         ca->get_graph()->get_nodes().size() -
-                                                                         1]->get_y()}, heuristic);
+            if (is_solvable)
+                solved_path = Solver::solve_maze_a_star(graph, start, end, heuristic);
+            if (is_solvable_from_player)
+                solved_path_from_player = Solver::solve_maze_a_star(graph, player_position, end, heuristic);
         }
     }
 
@@ -660,14 +553,14 @@ void solve_button_callback() {
 void reset_player_button_callback() {
     // Static maze -> reset the player to the start of the maze
     if (maze_type == MazeType::STATIC && maze) {
-        player = std::make_unique<Player>(maze->get_nodes()[0]->get_x(), maze->get_nodes()[0]->get_y());
+        player = std::make_unique<Player>(maze->get_x(0), maze->get_y(0));
     }
         // Dynamic maze -> reset the player to the start of the maze and reset the cellular automata
     else if (maze_type == MazeType::DYNAMIC && ca) {
-        player = std::make_unique<Player>(ca->get_graph()->get_nodes()[0]->get_x(),
-                                          ca->get_graph()->get_nodes()[0]->get_y());
+        player = std::make_unique<Player>(ca->get_graph()->get_x(0),
+                                          ca->get_graph()->get_y(0));
         ca->reset();
-        Drawing::buffer_graph(paths_vao, paths_vbo, paths_ebo, ca->get_graph(), paths_color);
+        paths_buffer.buffer_graph(ca->get_graph(), paths_color);
     }
     else
         return;
@@ -681,6 +574,38 @@ void reset_player_button_callback() {
     Drawing::buffer_lines(player_path_vao, player_path_vbo, player_path_ebo, player->get_path(), player_path_color);
 }
 
+/**
+ * Saves the current maze (or the current generation of the dynamic maze) into the maze file
+ */
+void save_maze_callback() {
+    if (maze_type == MazeType::STATIC && maze)
+        MazeFile::save(maze_filename, maze, seed);
+    else if (maze_type == MazeType::DYNAMIC && ca)
+        MazeFile::save(maze_filename, ca->get_graph(), seed);
+}
+
+/**
+ * Loads a static maze from the maze file
+ */
+void load_maze_callback() {
+    auto loaded = MazeFile::load(maze_filename, &seed);
+    if (!loaded)
+        return;
+
+    // Allow drawing
+    draw = true;
+
+    // The loaded maze is static, the base graph is the lattice it was generated on
+    maze_type = MazeType::STATIC;
+    graph_type = loaded->get_topology()->get_type();
+    graph = std::make_shared<Graph>(loaded->get_topology());
+    maze = loaded;
+
+    // Buffer the maze and reset the player to the start of the maze (this function also calls the solve button callback)
+    paths_buffer.buffer_graph(maze, paths_color);
+    reset_player_button_callback();
+}
+
 /**
  * Callback for the generate button
  * Generates a new maze based on the current settings
@@ -689,26 +614,33 @@ void generate_button_callback() {
     // Allow drawing
     draw = true;
 
+    // New seed (shown in the GUI, so the maze can be generated again)
+    if (random_seed)
+        seed = std::chrono::system_clock::now().time_since_epoch().count();
+
     // Generate Base Graph based on the graph type
     if (graph_type == GraphType::ORTHOGONAL)
         graph = Generator::create_orthogonal_grid_graph(WINDOW_HEIGHT / GRID_SIZE - 1, WINDOW_HEIGHT / GRID_SIZE - 1,
-                                                        non_grid_version);
+                                                        non_grid_version, seed);
     else if (graph_type == GraphType::HEXAGONAL)
         graph = Generator::create_hexagonal_grid_graph(WINDOW_HEIGHT / GRID_SIZE - 1, WINDOW_HEIGHT / GRID_SIZE - 1,
-                                                       non_grid_version);
+                                                       non_grid_version, seed);
     else if (graph_type == GraphType::LAPLACIAN)
         graph = Generator::create_orthogonal_grid_graph_laplacian(WINDOW_HEIGHT / GRID_SIZE - 1,
-                                                                  WINDOW_HEIGHT / GRID_SIZE - 1, non_grid_version);
+                                                                  WINDOW_HEIGHT / GRID_SIZE - 1, non_grid_version,
+                                                                  seed);
 
     // For static mazes, generate the maze based on the generator algorithm
     if (maze_type == MazeType::STATIC) {
         if (generator_algorithm == GeneratorType::DEPTH_FIRST_SEARCH)
-            maze = Generator::generate_maze_dfs(graph);
+            maze = Generator::generate_maze_dfs(graph, seed);
         else if (generator_algorithm == GeneratorType::KRUSKAL)
-            maze = Generator::generate_maze_kruskal(graph, horizontal_bias, vertical_bias, cycle_bias);
+            maze = Generator::generate_maze_kruskal(graph, horizontal_bias, vertical_bias, cycle_bias, seed);
+        else if (generator_algorithm == GeneratorType::ELLER)
+            maze = Generator::generate_maze_eller(graph, horizontal_bias, vertical_bias, seed);
 
         // Buffer the maze
-        Drawing::buffer_graph(paths_vao, paths_vbo, paths_ebo, maze, paths_color);
+        paths_buffer.buffer_graph(maze, paths_color);
     }
         // For dynamic mazes, set up the Cellular Automata
     else if (maze_type == MazeType::DYNAMIC) {
@@ -717,20 +649,22 @@ void generate_button_callback() {
             neighborhood = graph->create_copy();
         else if (neighborhood_graph_type == NeighborhoodGraphType::ORTHOGONAL)
             neighborhood = Generator::create_orthogonal_grid_graph(WINDOW_HEIGHT / GRID_SIZE - 1,
-                                                                   WINDOW_HEIGHT / GRID_SIZE - 1, non_grid_version);
+                                                                   WINDOW_HEIGHT / GRID_SIZE - 1, non_grid_version,
+                                                                   seed);
         else if (neighborhood_graph_type == NeighborhoodGraphType::HEXAGONAL)
             neighborhood = Generator::create_hexagonal_grid_graph(WINDOW_HEIGHT / GRID_SIZE - 1,
-                                                                  WINDOW_HEIGHT / GRID_SIZE - 1, non_grid_version);
+                                                                  WINDOW_HEIGHT / GRID_SIZE - 1, non_grid_version,
+                                                                  seed);
         else if (neighborhood_graph_type == NeighborhoodGraphType::LAPLACIAN)
             neighborhood = Generator::create_orthogonal_grid_graph_laplacian(WINDOW_HEIGHT / GRID_SIZE - 1,
                                                                              WINDOW_HEIGHT / GRID_SIZE - 1,
-                                                                             non_grid_version);
+                                                                             non_grid_version, seed);
 
         // Create the Cellular Automata
-        ca = std::make_unique<CellularAutomata>(rulestring, graph, neighborhood, initialize_square_size);
+        ca = std::make_unique<CellularAutomata>(rulestring, graph, neighborhood, initialize_square_size, seed);
 
         // Buffer the Cellular Automata (maze)
-        Drawing::buffer_graph(paths_vao, paths_vbo, paths_ebo, ca->get_graph(), paths_color);
+        paths_buffer.buffer_graph(ca->get_graph(), paths_color);
     }
 
     // Reset the player to the start of the maze (this function also calls the solve button callback)
@@ -848,62 +782,63 @@ int main(int argc, char **argv) {
             if (!paused && maze_type == MazeType::DYNAMIC && std::chrono::duration_cast<std::chrono::milliseconds>(
                     std::chrono::high_resolution_clock::now() - now).count() > (int) (1000 * (1.0f - speed))) {
                 // Do the next generation
-                ca->next_generation();
-                // Buffer the Cellular Automata (maze)
-                Drawing::buffer_graph(paths_vao, paths_vbo, paths_ebo, ca->get_graph(), paths_color);
+                auto &delta = ca->next_generation();
+                // Rewrite only the changed paths of the Cellular Automata (maze)
+                if (!delta.empty())
+                    paths_buffer.update_graph(ca->get_graph(), delta);
                 // Update the time
                 now = std::chrono::high_resolution_clock::now();
 
-                // Check if the player is standing on a dead node
+                // Check if the player is standing on a dead node (only possible if some node died)
                 auto player_node = ca->get_graph()->get_nearest_node_to(player->get_x(), player->get_y());
-                if (!(ca->get_graph()->get_nodes()[player_node]->is_alive())) {
+                if (!delta.died.empty() && !(ca->get_graph()->is_alive(player_node))) {
                     // Move the player to the nearest alive node
                     auto nearest_alive_node = ca->get_graph()->get_nearest_alive_node_to(player->get_x(),
                                                                                          player->get_y());
-                    player->move_to(ca->get_graph()->get_nodes()[nearest_alive_node]->get_x(),
-                                    ca->get_graph()->get_nodes()[nearest_alive_node]->get_y());
+                    player->move_to(ca->get_graph()->get_x(nearest_alive_node),
+                                    ca->get_graph()->get_y(nearest_alive_node));
                     // Buffer the player path
                     Drawing::buffer_lines(player_path_vao, player_path_vbo, player_path_ebo, player->get_path(),
                                           player_path_color);
                 }
 
-                // Do the solutions
-                solve_button_callback();
+                // Do the solutions (the maze only changes with the delta)
+                if (!delta.empty())
+                    solve_button_callback();
 
                 // Check if the player has reached the end
                 is_solved = is_solved ||
-                            (player->get_x() == ca->get_graph()->get_nodes()[ca->get_graph()->get_v() - 1]->get_x() &&
-                             player->get_y() == ca->get_graph()->get_nodes()[ca->get_graph()->get_v() - 1]->get_y());
+                            (player->get_x() == ca->get_graph()->get_x(ca->get_graph()->get_v() - 1) &&
+                             player->get_y() == ca->get_graph()->get_y(ca->get_graph()->get_v() - 1));
             }
 
             // Draw maze
             glLineWidth(WHITE_LINE_WIDTH);
-            paths_vao->bind();
-            glDrawElements(GL_LINES, paths_ebo->num_elements, GL_UNSIGNED_INT, 0);
-            paths_vao->unbind();
+            paths_buffer.draw();
 
             // Draw the nodes as circles to smooth the lines conjunctions
             if (maze_type == MazeType::STATIC) {
-                for (auto &node: maze->get_nodes())
-                    Drawing::draw_circle(node->get_x(), node->get_y(), WHITE_NODE_RADIUS, paths_color);
+                for (int i = 0; i < maze->get_v(); i++)
+                    Drawing::draw_circle(maze->get_x(i), maze->get_y(i), WHITE_NODE_RADIUS, paths_color);
             } else if (maze_type == MazeType::DYNAMIC) {
-                for (auto &node: ca->get_graph()->get_nodes())
-                    if (node->is_alive()) // Draw alive nodes only
-                        Drawing::draw_circle(node->get_x(), node->get_y(), WHITE_NODE_RADIUS, paths_color);
+                for (int i = 0; i < ca->get_graph()->get_v(); i++)
+                    if (ca->get_graph()->is_alive(i)) // Draw alive nodes only
+                        Drawing::draw_circle(ca->get_graph()->get_x(i), ca->get_graph()->get_y(i), WHITE_NODE_RADIUS,
+                                             paths_color);
             }
 
             // Color the start and end nodes
             if (maze_type == MazeType::STATIC) {
-                Drawing::draw_circle(maze->get_nodes()[0]->get_x(), maze->get_nodes()[0]->get_y(), PLAYER_RADIUS * 1.5f,
+                Drawing::draw_circle(maze->get_x(0), maze->get_y(0), PLAYER_RADIUS * 1.5f,
                                      start_end_color);
-                Drawing::draw_circle(maze->get_nodes()[maze->get_v() - 1]->get_x(),
-                                     maze->get_nodes()[maze->get_v() - 1]->get_y(), PLAYER_RADIUS * 1.5f,
+                Drawing::draw_circle(maze->get_x(maze->get_v() - 1),
+                                     maze->get_y(maze->get_v() - 1), PLAYER_RADIUS * 1.5f,
                                      start_end_color);
             } else if (maze_type == MazeType::DYNAMIC) {
-                Drawing::draw_circle(ca->get_graph()->get_nodes()[0]->get_x(), ca->get_graph()->get_nodes()[0]->get_y(),
+                Drawing::draw_circle(ca->get_graph()->get_x(0), ca->get_graph()->get_y(0),
                                      PLAYER_RADIUS * 1.5f, start_end_color);
-                Drawing::draw_circle(ca->get_graph()->get_nodes()[ca->get_graph()->get_v() - 1]->get_x(),
-                                     ca->get_graph()->get_nodes()[ca->get_graph()->get_v() - 1]->get_y(),
+                Drawing::draw_circle(ca->get_graph()->get_x(ca->get_graph()->get_v() - 1),
+                                     ca->get_graph()->get_y(ca->get_graph()->get_v() - 1),
                                      PLAYER_RADIUS * 1.5f, start_end_color);
             }
 
@@ -958,6 +893,7 @@ int main(int argc, char **argv) {
             const char *generator_algorithms[] = {
                     "Depth First Search",
                     "Kruskal's Modified Algorithm",
+                    "Eller's Algorithm"
             };
             // Solver algorithms
             const char *solver_algorithms[] = {
@@ -997,6 +933,12 @@ int main(int argc, char **argv) {
                     if (ImGui::MenuItem("Export as Image (raw maze)"))
                         export_as_image_raw_maze_callback(window);
                     ImGui::Separator();
+                    ImGui::InputText("Maze File", &maze_filename);
+                    if (ImGui::MenuItem("Save Maze"))
+                        save_maze_callback();
+                    if (ImGui::MenuItem("Load Maze"))
+                        load_maze_callback();
+                    ImGui::Separator();
                     if (ImGui::MenuItem("Exit", "Alt+F4"))
                         glfwSetWindowShouldClose(window, true);
                     ImGui::EndMenu();
@@ -1046,6 +988,11 @@ int main(int argc, char **argv) {
             ImGui::SameLine();
             help_marker(
                     "Non-Grid means that the graph appears as if it was not a grid\nEvery cell is randomly moved a little bit");
+            ImGui::InputScalar("Seed", ImGuiDataType_U64, &seed);
+            ImGui::Checkbox("Random Seed", &random_seed);
+            ImGui::SameLine();
+            help_marker(
+                    "The same seed and settings always generate the same maze (or the same Cellular Automata)\nIf Random Seed is checked, a new seed is chosen on every Generate and shown above");
 
             // For static mazes only
             if (maze_type == MazeType::STATIC) {
@@ -1075,6 +1022,21 @@ int main(int argc, char **argv) {
                     help_marker(
                             "Cycle Bias refers to the probability of cycles being created\nIf the value is 0, no cycles will be created, resulting in a Perfect Maze\nIf the value is 1, cycles will be created as much as possible, resulting in Fully Connected Graph");
                 }
+
+                // For Eller's Algorithm only
+                if (generator_algorithm == GeneratorType::ELLER) {
+                    ImGui::SameLine();
+                    help_marker(
+                            "Eller's Algorithm generates the maze row by row, keeping only one row in memory\nIt is meant for Orthogonal Grid Graphs, other graph types only get orthogonal paths");
+                    ImGui::SliderFloat("Horizontal Bias", &horizontal_bias, 0.0f, 1.0f);
+                    ImGui::SameLine();
+                    help_marker(
+                            "Horizontal Bias is the probability of joining two neighboring cells of a row\nIf the value is 0, only essential horizontal paths will be created\nIf the value is 1, rows will be joined as much as possible");
+                    ImGui::SliderFloat("Vertical Bias", &vertical_bias, 0.0f, 1.0f);
+                    ImGui::SameLine();
+                    help_marker(
+                            "Vertical Bias is the probability of a path leading down to the next row\nIf the value is 0, only essential vertical paths will be created\nIf the value is 1, every cell will have a path down");
+                }
             }
 
                 // For dynamic mazes only
@@ -1090,12 +1052,12 @@ int main(int argc, char **argv) {
                 auto temp_rulestring = rulestring;
                 if (ImGui::InputText("Rulestring", &temp_rulestring)) {
                     // On change, make sure that the rulestring is valid
-                    if (std::regex_match(temp_rulestring, rulestring_regex))
+                    if (Rule::is_valid(temp_rulestring))
                         rulestring = temp_rulestring;
                 }
                 ImGui::SameLine();
                 help_marker(
-                        "Rulestring format is B[0-9]+/S[0-9]+\nB is birth rule\nS is survival rule\nExample: Game of Life Rulestring is B3/S23");
+                        "Rulestring format is B[0-8]+/S[0-8]+\nB is birth rule\nS is survival rule\nExample: Game of Life Rulestring is B3/S23");
                 if (ImGui::InputInt("Initial Square Size", &initialize_square_size)) {
                     // On change, make sure that the initial square size is between -1 and the maximum possible size
                     if (initialize_square_size < -1) initialize_square_size = -1;
@@ -1276,10 +1238,9 @@ int main(int argc, char **argv) {
                 // Set the pathways color
                 if (ImGui::ColorEdit3("Maze Paths Color", (float *) &paths_color)) {
                     if (maze_type == MazeType::STATIC && maze)
-                        Drawing::buffer_graph(paths_vao, paths_vbo, paths_ebo, maze, paths_color); // Buffer the maze
+                        paths_buffer.buffer_graph(maze, paths_color); // Buffer the maze
                     else if (maze_type == MazeType::DYNAMIC && ca)
-                        Drawing::buffer_graph(paths_vao, paths_vbo, paths_ebo, ca->get_graph(),
-                                              paths_color); // Buffer the maze
+                        paths_buffer.buffer_graph(ca->get_graph(), paths_color); // Buffer the maze
                 }
                 // Set the start and end color
                 ImGui::ColorEdit3("Start and End Color", (float *) &start_end_color);
@@ -1342,9 +1303,7 @@ int main(int argc, char **argv) {
     if (background_vao) background_vao->del();
     if (background_vbo) background_vbo->del();
     if (background_ebo) background_ebo->del();
-    if (paths_vao) paths_vao->del();
-    if (paths_vbo) paths_vbo->del();
-    if (paths_ebo) paths_ebo->del();
+    paths_buffer.del();
     if (solution_vao) solution_vao->del();
     if (solution_vbo) solution_vbo->del();
     if (solution_ebo) solution_ebo->del();
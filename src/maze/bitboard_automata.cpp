@@ -0,0 +1,213 @@
+#include "bitboard_automata.h"
+#include <array>
+#include <cstring>
+
+/**
+ * Loads 64 packed flags starting at any bit position
+ * @param flags Packed flags (readable one word before and after the loaded bits)
+ * @param word Index of the word of the nodes
+ * @param offset Node offset of the loaded flags (negative offsets read the padding before the flags)
+ * @return Bit k is the flag of the node 64 * word + offset + k
+ */
+inline uint64_t load_shifted(const uint64_t *flags, int word, int offset) {
+    auto bit = static_cast<int64_t>(word) * 64 + offset;
+    auto index = bit >> 6; // Rounds towards minus infinity
+    auto shift = static_cast<int>(bit & 63);
+    return (flags[index] >> shift) | ((flags[index + 1] << 1) << (63 - shift)); // Two shifts, so shift 0 works
+}
+
+/**
+ * Transposes a matrix of 8 x 8 bits (bit 8 * r + c moves to 8 * c + r)
+ * @param x Matrix, row r is the byte r
+ * @return Transposed matrix
+ */
+inline uint64_t transpose_8x8(uint64_t x) {
+    auto t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAull;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCull;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ull;
+    x ^= t ^ (t << 28);
+    return x;
+}
+
+bool BitboardAutomata::is_supported(const Graph &original, const Graph &neighborhood) {
+    auto &topology = original.get_topology();
+    auto &neighborhood_topology = neighborhood.get_topology();
+    if (!topology->is_implicit() || !neighborhood_topology->is_implicit() ||
+        original.get_width() != neighborhood.get_width() || original.get_height() != neighborhood.get_height())
+        return false;
+
+    // Shifted words see every lattice neighbor, so no neighborhood edge may be closed
+    for (int i = 0; i < neighborhood.get_v(); i++)
+        if (neighborhood.get_open_mask(i) != neighborhood_topology->get_slot_mask(i))
+            return false;
+    return true;
+}
+
+BitboardAutomata::BitboardAutomata(const Graph &original, GraphType neighborhood_type)
+        : width{original.get_width()}, height{original.get_height()}, v{original.get_v()}, words{(v + 63) / 64},
+          padding{(height + 1) / 64 + 2}, type{original.get_topology()->get_type()},
+          neighborhood_type{neighborhood_type}, state(words + 2 * padding, 0), next_state(words + 2 * padding, 0),
+          first_row(words, 0), last_row(words, 0), even_columns(words, 0), original_masks(words * 64, 0),
+          masks(words * 64, 0), next_masks(words * 64, 0) {
+    for (int i = 0; i < width; i++) {
+        for (int j = 0; j < height; j++) {
+            auto node = i * height + j;
+            auto bit = 1ull << (node % 64);
+            if (j == 0)
+                first_row[node / 64] |= bit;
+            if (j == height - 1)
+                last_row[node / 64] |= bit;
+            if (i % 2 == 0)
+                even_columns[node / 64] |= bit;
+        }
+    }
+    original.read_open_masks(0, original_masks.data(), v);
+}
+
+template<GraphType TYPE>
+uint64_t BitboardAutomata::neighbor_flags(const uint64_t *alive, int word, int slot) const {
+    auto di = Lattice<TYPE>::DI[slot];
+    if (TYPE == GraphType::HEXAGONAL && slot >= 4) { // Diagonals go up from even columns and down from odd ones
+        auto even = even_columns[word];
+        return (load_shifted(alive, word, di * height - 1) & ~first_row[word] & even) |
+               (load_shifted(alive, word, di * height + 1) & ~last_row[word] & ~even);
+    }
+
+    // Columns out of the lattice read zeros, rows out of the lattice would wrap into the neighboring column
+    auto dj = Lattice<TYPE>::DJ_EVEN[slot];
+    auto flags = load_shifted(alive, word, di * height + dj);
+    if (dj == -1)
+        flags &= ~first_row[word];
+    else if (dj == 1)
+        flags &= ~last_row[word];
+    return flags;
+}
+
+template<GraphType TYPE>
+void BitboardAutomata::step(const Rule &rule) {
+    // Rule of every neighbor count as full words (all ones if the count makes the node alive)
+    std::array<uint64_t, MAX_DEGREE + 1> born_words{};
+    std::array<uint64_t, MAX_DEGREE + 1> survive_words{};
+    for (int count = 0; count <= Lattice<TYPE>::DEGREE; count++) {
+        born_words[count] = rule.next_state(false, count) ? ~0ull : 0;
+        survive_words[count] = rule.next_state(true, count) ? ~0ull : 0;
+    }
+
+    auto alive = state.data() + padding;
+    auto next = next_state.data() + padding;
+    for (int word = 0; word < words; word++) {
+        // Bit-sliced counters, bit k of the planes is the binary count of the alive neighbors of node 64 * word + k
+        uint64_t ones = 0, twos = 0, fours = 0, eights = 0;
+        for (int slot = 0; slot < Lattice<TYPE>::DEGREE; slot++) {
+            auto flags = neighbor_flags<TYPE>(alive, word, slot);
+            auto carry = ones & flags;
+            ones ^= flags;
+            auto carry_twos = twos & carry;
+            twos ^= carry;
+            auto carry_fours = fours & carry_twos;
+            fours ^= carry_twos;
+            eights |= carry_fours;
+        }
+
+        auto self = alive[word];
+        uint64_t result = 0;
+        for (int count = 0; count <= Lattice<TYPE>::DEGREE; count++) {
+            auto equal = (count & 1 ? ones : ~ones) & (count & 2 ? twos : ~twos) & (count & 4 ? fours : ~fours) &
+                         (count & 8 ? eights : ~eights);
+            result |= equal & ((self & survive_words[count]) | (~self & born_words[count]));
+        }
+        next[word] = result;
+    }
+
+    // Nodes past the last one stay dead, the start and the end always live
+    if (v % 64 != 0)
+        next[words - 1] &= (1ull << (v % 64)) - 1;
+    next[0] |= 1;
+    next[(v - 1) / 64] |= 1ull << ((v - 1) % 64);
+}
+
+template<GraphType TYPE>
+void BitboardAutomata::resolve_edges() {
+    auto alive = next_state.data() + padding;
+    for (int word = 0; word < words; word++) {
+        // Plane of every slot, bit k is set if node 64 * word + k and its neighbor in the slot are both alive
+        std::array<uint64_t, MAX_DEGREE> planes{};
+        uint64_t connected = 0;
+        for (int slot = 0; slot < Lattice<TYPE>::DEGREE; slot++) {
+            planes[slot] = alive[word] & neighbor_flags<TYPE>(alive, word, slot);
+            connected |= planes[slot];
+        }
+
+        // Eight nodes at once, the planes are the rows of a bit matrix and the masks of the nodes are its columns
+        for (int part = 0; part < 8; part++) {
+            if (((connected >> (8 * part)) & 0xFF) == 0) { // No edges (dead or isolated nodes)
+                std::memset(next_masks.data() + 64 * word + 8 * part, 0, 8);
+                continue;
+            }
+            uint64_t matrix = 0;
+            for (int slot = 0; slot < MAX_DEGREE; slot++)
+                matrix |= ((planes[slot] >> (8 * part)) & 0xFF) << (8 * slot);
+            uint64_t original;
+            std::memcpy(&original, original_masks.data() + 64 * word + 8 * part, 8);
+            matrix = transpose_8x8(matrix) & original;
+            std::memcpy(next_masks.data() + 64 * word + 8 * part, &matrix, 8);
+        }
+    }
+}
+
+void BitboardAutomata::next_generation(const Graph &current, Graph &next, const Rule &rule, GenerationDelta &delta) {
+    // The current graph may have been changed since the last generation (for example by a reset), so it is read again
+    for (int word = 0; word < words; word++)
+        state[padding + word] = current.get_alive_word(word);
+    if (v % 64 != 0)
+        state[padding + words - 1] &= (1ull << (v % 64)) - 1;
+    current.read_open_masks(0, masks.data(), v);
+
+    if (neighborhood_type == GraphType::ORTHOGONAL)
+        step<GraphType::ORTHOGONAL>(rule);
+    else if (neighborhood_type == GraphType::HEXAGONAL)
+        step<GraphType::HEXAGONAL>(rule);
+    else
+        step<GraphType::LAPLACIAN>(rule);
+
+    if (type == GraphType::ORTHOGONAL)
+        resolve_edges<GraphType::ORTHOGONAL>();
+    else if (type == GraphType::HEXAGONAL)
+        resolve_edges<GraphType::HEXAGONAL>();
+    else
+        resolve_edges<GraphType::LAPLACIAN>();
+
+    next.write_alive_words(0, next_state.data() + padding, words);
+    next.write_open_masks(0, next_masks.data(), v);
+    next.touch();
+
+    // Delta from the packed states, unchanged words and groups of eight masks are skipped at once
+    delta.clear();
+    for (int word = 0; word < words; word++) {
+        auto alive = next_state[padding + word];
+        for (auto changed = state[padding + word] ^ alive; changed; changed &= changed - 1) {
+            auto bit = std::countr_zero(changed);
+            ((alive >> bit) & 1 ? delta.born : delta.died).push_back(word * 64 + bit);
+        }
+    }
+    auto &topology = next.get_topology();
+    for (int first = 0; first < v; first += 8) {
+        uint64_t old_group, new_group;
+        std::memcpy(&old_group, masks.data() + first, 8);
+        std::memcpy(&new_group, next_masks.data() + first, 8);
+        if (old_group == new_group)
+            continue;
+
+        // Every changed edge is seen from both ends, report it from the smaller one
+        for (int i = first; i < std::min(first + 8, v); i++) {
+            for (unsigned changed = masks[i] ^ next_masks[i]; changed; changed &= changed - 1) {
+                auto slot = std::countr_zero(changed);
+                auto j = topology->get_neighbor(i, slot);
+                if (i < j)
+                    ((next_masks[i] >> slot) & 1 ? delta.opened : delta.closed).emplace_back(i, j);
+            }
+        }
+    }
+}
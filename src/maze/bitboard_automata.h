@@ -0,0 +1,99 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "graph.h"
+#include "generation_delta.h"
+#include "rule.h"
+
+/**
+ * Cellular automata engine on packed alive flags of a lattice (64 nodes per word, in the node order of the graph)
+ * Neighbors of 64 nodes at once are the alive words shifted by the node offset of a lattice slot,
+ * their counts are summed with bit-sliced adders and the rule is applied to whole words,
+ * the edges between alive nodes are derived from the packed state as well
+ * Works for lattice graphs with a complete lattice neighborhood of the same size only (see is_supported)
+ */
+class BitboardAutomata {
+private:
+    /** Width of the lattice */
+    int width;
+    /** Height of the lattice */
+    int height;
+    /** Number of vertices */
+    int v;
+    /** Number of words of the packed state */
+    int words;
+    /** Number of zero words before and after the packed state (longer than the longest shift) */
+    int padding;
+    /** Lattice type of the graph (slots of the edges) */
+    GraphType type;
+    /** Lattice type of the neighborhood */
+    GraphType neighborhood_type;
+    /** Alive flags of the current generation with the zero padding on both sides */
+    std::vector<uint64_t> state;
+    /** Alive flags of the next generation */
+    std::vector<uint64_t> next_state;
+    /** Flags of the nodes in the first row (no neighbor above) */
+    std::vector<uint64_t> first_row;
+    /** Flags of the nodes in the last row (no neighbor below) */
+    std::vector<uint64_t> last_row;
+    /** Flags of the nodes in even columns (hexagonal diagonals depend on the column parity) */
+    std::vector<uint64_t> even_columns;
+    /** Open slot masks of the original grid graph (edges can only be open where they are open there) */
+    std::vector<uint8_t> original_masks;
+    /** Open slot masks of the current generation */
+    std::vector<uint8_t> masks;
+    /** Open slot masks of the next generation */
+    std::vector<uint8_t> next_masks;
+
+    /**
+     * Computes the alive flags of the neighbors in one slot of 64 nodes
+     * @tparam TYPE Lattice type
+     * @param alive Packed alive flags (with the zero padding around)
+     * @param word Index of the word of the nodes
+     * @param slot Slot of the neighbors
+     * @return Bit k is set if the node 64 * word + k has an alive neighbor in the slot
+     */
+    template<GraphType TYPE>
+    [[nodiscard]] uint64_t neighbor_flags(const uint64_t *alive, int word, int slot) const;
+
+    /**
+     * Computes the alive flags of the next generation
+     * @tparam TYPE Lattice type of the neighborhood
+     * @param rule Rule of the cellular automata
+     */
+    template<GraphType TYPE>
+    void step(const Rule &rule);
+
+    /**
+     * Computes the open slot masks of the next generation (edges between alive nodes)
+     * @tparam TYPE Lattice type of the graph
+     */
+    template<GraphType TYPE>
+    void resolve_edges();
+
+public:
+    /**
+     * Checks if the engine can run the cellular automata of the graphs
+     * @param original Original grid graph
+     * @param neighborhood Neighborhood graph
+     * @return True if both graphs are lattices of the same size and the neighborhood has all its edges open
+     */
+    static bool is_supported(const Graph &original, const Graph &neighborhood);
+
+    /**
+     * Constructor
+     * @param original Original grid graph (lattice)
+     * @param neighborhood_type Lattice type of the neighborhood
+     */
+    BitboardAutomata(const Graph &original, GraphType neighborhood_type);
+
+    /**
+     * Computes the next generation (nodes 0 and V - 1 always stay alive)
+     * @param current Graph of the current generation
+     * @param next Graph of the next generation (copy of the current one, overwritten)
+     * @param rule Rule of the cellular automata
+     * @param delta Changes made by the generation (output)
+     */
+    void next_generation(const Graph &current, Graph &next, const Rule &rule, GenerationDelta &delta);
+};
@@ -1,8 +1,75 @@
 #include "cellular_automata.h"
+#include <algorithm>
+
+/** Generations after at most V / ACTIVE_SET_DIVISOR changed nodes evaluate only the active nodes (more changes are cheaper to sweep) */
+constexpr int64_t ACTIVE_SET_DIVISOR = 16;
+
+/**
+ * Counts the alive neighbors of every node in a lattice neighborhood
+ * @tparam TYPE Lattice type of the neighborhood
+ * @param graph Current graph
+ * @param neighborhood Neighborhood graph (lattice of the same size)
+ * @param counts Number of alive neighbors of every node (output)
+ */
+template<GraphType TYPE>
+void count_alive_neighbors_lattice(const Graph &graph, const Graph &neighborhood, std::vector<uint8_t> &counts) {
+    auto width = graph.get_width();
+    auto height = graph.get_height();
+    for (int i = 0; i < width; i++) {
+        for (int j = 0; j < height; j++) {
+            uint8_t count = 0;
+            Lattice<TYPE>::for_each_neighbor(i, j, height, neighborhood.get_open_mask(i * height + j),
+                                             [&](int n) { count += graph.is_alive(n); });
+            counts[i * height + j] = count;
+        }
+    }
+}
+
+/**
+ * Counts the alive neighbors of every node in any neighborhood
+ * Only the row of every node is visited, so counting is O(V * degree)
+ * @param graph Current graph
+ * @param neighborhood Neighborhood graph (with the same number of nodes)
+ * @param counts Number of alive neighbors of every node (output)
+ */
+void count_alive_neighbors_generic(const Graph &graph, const Graph &neighborhood, std::vector<uint8_t> &counts) {
+    for (int i = 0; i < graph.get_v(); i++) {
+        uint8_t count = 0;
+        neighborhood.for_each_neighbor(i, [&](int n) { count += graph.is_alive(n); });
+        counts[i] = count;
+    }
+}
+
+/**
+ * Restricts a neighborhood graph to the nodes of a graph of another size (nodes are matched by their indices)
+ * @param neighborhood Neighborhood graph
+ * @param graph Graph of the cellular automata
+ * @return Neighborhood graph with the nodes of the graph and the neighbor lists of the nodes existing in both
+ */
+std::shared_ptr<Graph> restrict_neighborhood(const Graph &neighborhood, const Graph &graph) {
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i < std::min(neighborhood.get_v(), graph.get_v()); i++)
+        neighborhood.for_each_neighbor(i, [&](int n) {
+            if (i < n && n < graph.get_v()) // Every edge only once
+                edges.emplace_back(i, n);
+        });
+
+    std::vector<int> xs(graph.get_v());
+    std::vector<int> ys(graph.get_v());
+    for (int i = 0; i < graph.get_v(); i++) {
+        xs[i] = graph.get_x(i);
+        ys[i] = graph.get_y(i);
+    }
+    return std::make_shared<Graph>(std::make_shared<Topology>(graph.get_width(), graph.get_height(), edges,
+                                                              std::move(xs), std::move(ys)));
+}
 
 CellularAutomata::CellularAutomata(std::string rules, std::shared_ptr<Graph> &orig_graph,
-                                   const std::shared_ptr<Graph> &neighborhood, const int init_square_w) : rule_string(
-        std::move(rules)), born_rule(), survive_rule() {
+                                   const std::shared_ptr<Graph> &neighborhood, const int init_square_w,
+                                   uint64_t seed) : rule(), counts_valid{false}, delta_from_rule{false},
+                                                     graph_version{0}, next_subscriber_id{0} {
+    Rule::parse(rules, rule);
+
     // Create copy of original graph
     original_grid_graph = orig_graph;
     graph = orig_graph->create_copy();
@@ -12,90 +79,227 @@ CellularAutomata::CellularAutomata(std::string rules, std::shared_ptr<Graph> &or
     else
         neighborhood_graph = orig_graph->create_copy();
 
-    std::default_random_engine gen(std::chrono::system_clock::now().time_since_epoch().count());
-    std::uniform_int_distribution<> dis(0, 1);
+    Philox gen(seed, RandomStream::CELLULAR_AUTOMATA);
     auto width = graph->get_width();
     if (init_square_w > -1)
         width = init_square_w;
 
-    // Randomly set nodes to alive or dead
+    // Randomly set nodes to alive or dead (one substream per node, the state of a node depends only on the seed)
     for (int i = 1; i < graph->get_v() - 1; i++) {
         if (i / graph->get_width() < width && i % graph->get_width() < width) {
-            if (dis(gen) == 1) {
-                graph->get_nodes()[i]->set_alive(false);
-                for (int j = 0; j < graph->get_v(); j++)
-                    graph->remove_edge(i, j);
+            if (gen.substream(i)() & 1) {
+                graph->set_alive(i, false);
+                graph->clear_edges(i);
             }
         } else {
-            graph->get_nodes()[i]->set_alive(false);
-            for (int j = 0; j < graph->get_v(); j++)
-                graph->remove_edge(i, j);
+            graph->set_alive(i, false);
+            graph->clear_edges(i);
         }
     }
 
     // Save initial state
     initialized_graph = graph->create_copy();
 
-    // Parse rules
-    for (int i = 0; i < rule_string.length(); i++) {
-        if (rule_string[i] == 'B') {
-            for (int j = i + 1; j < rule_string.find_first_of('/'); j++) {
-                born_rule.push_back(rule_string[j] - '0');
-            }
-        } else if (rule_string[i] == 'S') {
-            for (int j = i + 1; j < rule_string.length(); j++) {
-                survive_rule.push_back(rule_string[j] - '0');
-            }
-        }
-    }
+    // Second buffer for the next generation, both own their pages, so the generations are computed without allocations
+    spare_graph = graph->create_copy();
+    graph->make_unique();
+    spare_graph->make_unique();
+
+    // Choose the counting kernel once, lattice neighborhoods use the compile-time offsets
+    alive_neighbors.resize(graph->get_v());
+    is_active.resize(graph->get_v(), false);
+    if (neighborhood_graph->get_width() != graph->get_width() || neighborhood_graph->get_height() != graph->get_height())
+        neighborhood_graph = restrict_neighborhood(*neighborhood_graph, *graph);
+    auto &neighborhood_topology = neighborhood_graph->get_topology();
+    if (!neighborhood_topology->is_implicit())
+        count_alive_neighbors = count_alive_neighbors_generic;
+    else if (neighborhood_topology->get_type() == GraphType::ORTHOGONAL)
+        count_alive_neighbors = count_alive_neighbors_lattice<GraphType::ORTHOGONAL>;
+    else if (neighborhood_topology->get_type() == GraphType::HEXAGONAL)
+        count_alive_neighbors = count_alive_neighbors_lattice<GraphType::HEXAGONAL>;
+    else
+        count_alive_neighbors = count_alive_neighbors_lattice<GraphType::LAPLACIAN>;
+
+    // Lattices with a complete lattice neighborhood run on the packed engine
+    if (BitboardAutomata::is_supported(*original_grid_graph, *neighborhood_graph))
+        bitboard = std::make_unique<BitboardAutomata>(*original_grid_graph,
+                                                      neighborhood_graph->get_topology()->get_type());
 }
 
 std::shared_ptr<Graph> &CellularAutomata::get_graph() {
     return graph;
 }
 
-void CellularAutomata::next_generation() {
-    auto new_graph = graph->create_copy();
-    for (int i = 0; i < graph->get_v(); i++) {
-        auto alive_neighbors = 0;
-        for (int j = 0; j < graph->get_v(); j++) {
-            if (neighborhood_graph->is_adjacent(i, j) && graph->get_nodes()[j]->is_alive())
-                alive_neighbors++;
-        }
+const GenerationDelta &CellularAutomata::next_generation() {
+    auto &next = get_spare_graph();
+
+    // Few changes made by the rule (and nothing changed from outside), so only their neighborhoods can change now
+    auto changed = static_cast<int64_t>(delta.born.size() + delta.died.size());
+    if (delta_from_rule && graph->get_version() == graph_version && changed * ACTIVE_SET_DIVISOR <= graph->get_v()) {
+        next_generation_active(next);
+    } else if (bitboard) {
+        bitboard->next_generation(*graph, next, rule, delta);
+        counts_valid = false;
+    } else {
+        next_generation_full(next);
+        counts_valid = false;
+    }
 
-        if ((graph->get_nodes()[i]->is_alive() && std::count(survive_rule.begin(), survive_rule.end(), alive_neighbors))
-            || (!graph->get_nodes()[i]->is_alive() && std::count(born_rule.begin(), born_rule.end(), alive_neighbors)))
-            new_graph->get_nodes()[i]->set_alive(true);
-        else
-            new_graph->get_nodes()[i]->set_alive(false);
+    notify_subscribers();
+    std::swap(graph, spare_graph);
+    delta_from_rule = true;
+    graph_version = graph->get_version();
+    return delta;
+}
+
+void CellularAutomata::next_generation_full(Graph &next) {
+    next.copy_from(*graph);
+
+    count_alive_neighbors(*graph, *neighborhood_graph, alive_neighbors);
+    for (int i = 0; i < graph->get_v(); i++) {
+        next.set_alive(i, rule.next_state(graph->is_alive(i), alive_neighbors[i]));
     }
 
     // Set start and end nodes to alive
-    new_graph->get_nodes()[0]->set_alive(true);
-    new_graph->get_nodes()[graph->get_v() - 1]->set_alive(true);
-
-    // Resolve edges
-    for (int i = 0; i < new_graph->get_v(); i++) {
-        std::vector<int> possible_neighbors;
-        for (int j = 0; j < new_graph->get_v(); j++) {
-            if (original_grid_graph->is_adjacent(i, j))
-                possible_neighbors.push_back(j);
-        }
-        if (new_graph->get_nodes()[i]->is_alive()) {
-            for (int possible_neighbor: possible_neighbors) {
-                if (new_graph->get_nodes()[possible_neighbor]->is_alive())
-                    new_graph->add_edge(i, possible_neighbor);
+    next.set_alive(0, true);
+    next.set_alive(graph->get_v() - 1, true);
+
+    // Resolve edges (the graph is a copy of the original grid graph, so they share the slots)
+    auto &topology = next.get_topology();
+    for (int i = 0; i < next.get_v(); i++) {
+        if (next.is_alive(i)) {
+            for (unsigned mask = original_grid_graph->get_open_mask(i); mask; mask &= mask - 1) {
+                auto slot = std::countr_zero(mask);
+                if (next.is_alive(topology->get_neighbor(i, slot)))
+                    next.open_slot(i, slot);
             }
         } else {
-            for (int j = 0; j < new_graph->get_v(); j++) {
-                new_graph->remove_edge(i, j);
-            }
+            next.clear_edges(i);
         }
     }
 
-    graph = new_graph;
+    compute_delta(*graph, next);
+}
+
+void CellularAutomata::next_generation_active(Graph &next) {
+    // The spare graph is the previous generation, the last delta brings it to the current one
+    next.apply_delta(delta);
+    if (!counts_valid) {
+        count_alive_neighbors(*graph, *neighborhood_graph, alive_neighbors);
+        counts_valid = true;
+    }
+
+    // Nodes that changed or have a changed neighbor, the others are stable under the rule
+    active.clear();
+    auto activate = [&](int n) {
+        if (!is_active[n]) {
+            is_active[n] = true;
+            active.push_back(n);
+        }
+    };
+    for (auto i: delta.born) {
+        activate(i);
+        neighborhood_graph->for_each_neighbor(i, activate);
+    }
+    for (auto i: delta.died) {
+        activate(i);
+        neighborhood_graph->for_each_neighbor(i, activate);
+    }
+
+    delta.clear();
+    auto last = graph->get_v() - 1;
+    for (auto i: active) {
+        is_active[i] = false;
+        auto alive = graph->is_alive(i);
+        auto new_alive = i == 0 || i == last || rule.next_state(alive, alive_neighbors[i]);
+        if (new_alive != alive) {
+            next.set_alive(i, new_alive);
+            (new_alive ? delta.born : delta.died).push_back(i);
+        }
+    }
+    std::sort(delta.born.begin(), delta.born.end());
+    std::sort(delta.died.begin(), delta.died.end());
+
+    // Only edges of the changed nodes change, an edge between two changed nodes is reported from the smaller one
+    auto &topology = next.get_topology();
+    for (auto i: delta.died) {
+        for (unsigned mask = graph->get_open_mask(i); mask; mask &= mask - 1) {
+            auto j = topology->get_neighbor(i, std::countr_zero(mask));
+            if (i < j || next.is_alive(j))
+                delta.closed.emplace_back(std::min(i, j), std::max(i, j));
+        }
+        next.clear_edges(i);
+    }
+    for (auto i: delta.born) {
+        for (unsigned mask = original_grid_graph->get_open_mask(i); mask; mask &= mask - 1) {
+            auto slot = std::countr_zero(mask);
+            auto j = topology->get_neighbor(i, slot);
+            if (!next.is_alive(j))
+                continue;
+            next.open_slot(i, slot);
+            if (i < j || graph->is_alive(j))
+                delta.opened.emplace_back(std::min(i, j), std::max(i, j));
+        }
+    }
+
+    // Keep the counts in step with the new generation
+    for (auto i: delta.born)
+        neighborhood_graph->for_each_neighbor(i, [&](int n) { alive_neighbors[n]++; });
+    for (auto i: delta.died)
+        neighborhood_graph->for_each_neighbor(i, [&](int n) { alive_neighbors[n]--; });
+}
+
+const GenerationDelta &CellularAutomata::reset() {
+    auto &next = get_spare_graph();
+    next.copy_from(*initialized_graph);
+    compute_delta(*graph, next);
+    notify_subscribers();
+    std::swap(graph, spare_graph);
+    delta_from_rule = false;
+    counts_valid = false;
+    return delta;
+}
+
+Graph &CellularAutomata::get_spare_graph() {
+    // Someone still holds the graph of an older generation, it must not change under their hands
+    if (spare_graph.use_count() > 1) {
+        spare_graph = graph->create_copy();
+        spare_graph->make_unique();
+    }
+    return *spare_graph;
+}
+
+void CellularAutomata::compute_delta(const Graph &old_graph, const Graph &new_graph) {
+    delta.clear();
+    auto &topology = new_graph.get_topology();
+    for (int i = 0; i < new_graph.get_v(); i++) {
+        if (old_graph.is_alive(i) != new_graph.is_alive(i))
+            (new_graph.is_alive(i) ? delta.born : delta.died).push_back(i);
+
+        // Every changed edge is seen from both ends, report it from the smaller one
+        for (unsigned changed = old_graph.get_open_mask(i) ^ new_graph.get_open_mask(i); changed; changed &= changed - 1) {
+            auto slot = std::countr_zero(changed);
+            auto j = topology->get_neighbor(i, slot);
+            if (i < j)
+                (new_graph.is_open(i, slot) ? delta.opened : delta.closed).emplace_back(i, j);
+        }
+    }
+}
+
+void CellularAutomata::notify_subscribers() {
+    for (auto &[id, callback]: subscribers)
+        callback(delta);
+}
+
+const GenerationDelta &CellularAutomata::get_last_delta() const {
+    return delta;
+}
+
+int CellularAutomata::subscribe(std::function<void(const GenerationDelta &)> callback) {
+    subscribers.emplace_back(next_subscriber_id, std::move(callback));
+    return next_subscriber_id++;
 }
 
-void CellularAutomata::reset() {
-    graph = initialized_graph->create_copy();
+void CellularAutomata::unsubscribe(int id) {
+    std::erase_if(subscribers, [id](const auto &subscriber) { return subscriber.first == id; });
 }
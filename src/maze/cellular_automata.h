@@ -1,8 +1,12 @@
 #pragma once
 
 #include <utility>
+#include <functional>
 #include "graph.h"
 #include "generator.h"
+#include "philox.h"
+#include "bitboard_automata.h"
+#include "rule.h"
 
 /**
  * Cellular automata represented by a graph
@@ -13,26 +17,78 @@ private:
     std::shared_ptr<Graph> original_grid_graph;
     /** Current graph (changes with each generation) */
     std::shared_ptr<Graph> graph;
+    /** Graph of the next generation (swapped with the current graph after every generation) */
+    std::shared_ptr<Graph> spare_graph;
     /** Neighborhood graph (for checking alive nodes around) */
     std::shared_ptr<Graph> neighborhood_graph;
     /** Initial graph (for resetting) */
     std::shared_ptr<Graph> initialized_graph;
-    /** String of rules */
-    std::string rule_string;
-    /** Born rule */
-    std::vector<int> born_rule;
-    /** Survival rule */
-    std::vector<int> survive_rule;
+    /** Rule compiled from the rulestring */
+    Rule rule;
+    /** Engine on packed alive flags (null if the graphs are not lattices it supports) */
+    std::unique_ptr<BitboardAutomata> bitboard;
+    /** Number of alive neighbors of every node (filled by the counting kernel) */
+    std::vector<uint8_t> alive_neighbors;
+    /** Kernel counting the alive neighbors (chosen once by the neighborhood topology) */
+    void (*count_alive_neighbors)(const Graph &graph, const Graph &neighborhood, std::vector<uint8_t> &counts);
+    /** True if the alive neighbors are counted in the current graph (kept up to date by the active generations only) */
+    bool counts_valid;
+    /** Nodes evaluated by an active generation (changed in the last generation or next to a changed node) */
+    std::vector<int> active;
+    /** Flags of the nodes in the active list (no node is evaluated twice) */
+    std::vector<uint8_t> is_active;
+    /** True if the last delta was made by the rule (not by a reset), so the nodes outside it and its neighborhoods are stable */
+    bool delta_from_rule;
+    /** Version of the current graph after the last generation (the graph was changed from outside if it differs) */
+    uint64_t graph_version;
+    /** Changes made by the last generation (or reset) */
+    GenerationDelta delta;
+    /** Callbacks notified about every delta (with their subscription IDs) */
+    std::vector<std::pair<int, std::function<void(const GenerationDelta &)>>> subscribers;
+    /** ID of the next subscription */
+    int next_subscriber_id;
+
+    /**
+     * Computes the delta between two graphs
+     * @param old_graph Graph before the change
+     * @param new_graph Graph after the change
+     */
+    void compute_delta(const Graph &old_graph, const Graph &new_graph);
+
+    /**
+     * Computes the next generation by evaluating every node and resolving every edge
+     * @param next Graph of the next generation (overwritten)
+     */
+    void next_generation_full(Graph &next);
+
+    /**
+     * Computes the next generation by evaluating only the nodes of the last delta and their neighbors
+     * and resolving only the edges of the changed nodes, O(changes) instead of O(V)
+     * @param next Graph of the previous generation (brought to the next generation)
+     */
+    void next_generation_active(Graph &next);
+
+    /**
+     * Getter for the buffer of the next generation (replaced by a new one if the old one is still held outside)
+     * @return Graph of the next generation (its contents are overwritten by the caller)
+     */
+    Graph &get_spare_graph();
+
+    /**
+     * Notifies the subscribers about the current delta
+     */
+    void notify_subscribers();
 
 public:
     /**
      * Constructor
-     * @param rules Rules of the cellular automata (format B/S)
+     * @param rules Rules of the cellular automata (format B/S, an invalid rulestring gives a rule where nothing lives)
      * @param orig_graph Original graph
      * @param neighborhood Neighborhood graph
      * @param init_square_w Initial square width
+     * @param seed Seed of the initial state
      */
-    CellularAutomata(std::string rules, std::shared_ptr<Graph>& orig_graph, const std::shared_ptr<Graph>& neighborhood = nullptr, const int init_square_w = -1);
+    CellularAutomata(std::string rules, std::shared_ptr<Graph>& orig_graph, const std::shared_ptr<Graph>& neighborhood = nullptr, const int init_square_w = -1, uint64_t seed = 0);
 
     /**
      * Get current graph
@@ -42,11 +98,33 @@ public:
 
     /**
      * Do next generation
+     * After a generation with few changes only the active nodes are evaluated, otherwise all of them
+     * @return Changes made by the generation
      */
-    void next_generation();
+    const GenerationDelta &next_generation();
 
     /**
      * Reset graph to initial state
+     * @return Changes made by the reset
+     */
+    const GenerationDelta &reset();
+
+    /**
+     * Get changes made by the last generation (or reset)
+     * @return Last delta
+     */
+    [[nodiscard]] const GenerationDelta &get_last_delta() const;
+
+    /**
+     * Subscribe to the deltas of the generations (and resets)
+     * @param callback Function called with every delta
+     * @return Subscription ID
+     */
+    int subscribe(std::function<void(const GenerationDelta &)> callback);
+
+    /**
+     * Cancel a subscription
+     * @param id Subscription ID
      */
-    void reset();
+    void unsubscribe(int id);
 };
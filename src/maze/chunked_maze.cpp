@@ -0,0 +1,206 @@
+#include "chunked_maze.h"
+
+/** Number of cells of a tile */
+constexpr int64_t CHUNK_TILE_CELLS = CHUNK_TILE_SIZE * CHUNK_TILE_SIZE;
+/** Offset of the first tile in the backing file (after the header, page aligned) */
+constexpr int64_t CHUNK_TILES_OFFSET = 4096;
+/** Version of the backing file format */
+constexpr uint32_t CHUNK_FILE_VERSION = 1;
+
+/**
+ * Header of the backing file
+ */
+struct ChunkedMazeHeader {
+    /** Magic bytes "CMAZ" */
+    char magic[4];
+    /** Version of the file format */
+    uint32_t version;
+    /** Lattice type (GraphType) */
+    uint32_t type;
+    /** Reserved (zero) */
+    uint32_t reserved;
+    /** Width of the maze */
+    int64_t width;
+    /** Height of the maze */
+    int64_t height;
+};
+static_assert(sizeof(ChunkedMazeHeader) == 32);
+
+ChunkedMaze::ChunkedMaze(const std::string &filename, GraphType type, int64_t width, int64_t height, size_t capacity)
+        : width{width}, height{height}, type{type}, tiles_y{(height + CHUNK_TILE_SIZE - 1) / CHUNK_TILE_SIZE},
+          capacity{std::max<size_t>(capacity, 2)}, last_tile{-1}, last{nullptr}, write_failed{false} {
+    file.open(filename, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+
+    ChunkedMazeHeader header{};
+    std::copy_n("CMAZ", 4, header.magic);
+    header.version = CHUNK_FILE_VERSION;
+    header.type = static_cast<uint32_t>(type);
+    header.width = width;
+    header.height = height;
+    if (!file.write(reinterpret_cast<const char *>(&header), sizeof(header))) {
+        std::cerr << "Could not create the maze file " << filename << "\n";
+        file.close();
+    }
+}
+
+ChunkedMaze::ChunkedMaze(const std::string &filename, size_t capacity)
+        : width{0}, height{0}, type{GraphType::ORTHOGONAL}, tiles_y{0}, capacity{std::max<size_t>(capacity, 2)},
+          last_tile{-1}, last{nullptr}, write_failed{false} {
+    file.open(filename, std::ios::in | std::ios::out | std::ios::binary);
+
+    ChunkedMazeHeader header{};
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        !std::equal(header.magic, header.magic + 4, "CMAZ") || header.version != CHUNK_FILE_VERSION ||
+        header.type > static_cast<uint32_t>(GraphType::LAPLACIAN) || header.width <= 0 || header.height <= 0 || header.width > INT64_MAX / header.height) {
+        std::cerr << "Could not open the maze file " << filename << "\n";
+        file.close();
+        return;
+    }
+    width = header.width;
+    height = header.height;
+    type = static_cast<GraphType>(header.type);
+    tiles_y = (height + CHUNK_TILE_SIZE - 1) / CHUNK_TILE_SIZE;
+}
+
+ChunkedMaze::~ChunkedMaze() {
+    flush();
+}
+
+bool ChunkedMaze::is_open() const {
+    return file.is_open();
+}
+
+int64_t ChunkedMaze::get_width() const {
+    return width;
+}
+
+int64_t ChunkedMaze::get_height() const {
+    return height;
+}
+
+int64_t ChunkedMaze::get_v() const {
+    return width * height;
+}
+
+GraphType ChunkedMaze::get_type() const {
+    return type;
+}
+
+int64_t ChunkedMaze::locate(int64_t cell, int64_t &offset) const {
+    auto i = cell / height;
+    auto j = cell % height;
+    offset = (i % CHUNK_TILE_SIZE) * CHUNK_TILE_SIZE + j % CHUNK_TILE_SIZE;
+    return (i / CHUNK_TILE_SIZE) * tiles_y + j / CHUNK_TILE_SIZE;
+}
+
+void ChunkedMaze::write_tile(int64_t tile, const std::vector<uint8_t> &cells) {
+    file.clear();
+    file.seekp(CHUNK_TILES_OFFSET + tile * CHUNK_TILE_CELLS);
+    if (!file.write(reinterpret_cast<const char *>(cells.data()), CHUNK_TILE_CELLS) && !write_failed) {
+        std::cerr << "Could not write into the maze file, changes of the maze are lost\n";
+        write_failed = true; // Reported once, flush returns false from now on
+    }
+}
+
+ChunkedMaze::Tile &ChunkedMaze::get_tile(int64_t tile) {
+    if (tile == last_tile)
+        return *last;
+
+    auto it = tiles.find(tile);
+    if (it != tiles.end()) { // Cached -> move to the front of the LRU list
+        lru.splice(lru.begin(), lru, it->second.position);
+    } else {
+        // Evict the least recently used tile
+        if (tiles.size() >= capacity) {
+            auto evicted = tiles.find(lru.back());
+            if (evicted->second.dirty)
+                write_tile(evicted->first, evicted->second.cells);
+            tiles.erase(evicted);
+            lru.pop_back();
+        }
+
+        // Load the tile, the part beyond the end of the file was never written (all walls)
+        lru.push_front(tile);
+        it = tiles.emplace(tile, Tile{std::vector<uint8_t>(CHUNK_TILE_CELLS, 0), false, lru.begin()}).first;
+        file.clear();
+        file.seekg(CHUNK_TILES_OFFSET + tile * CHUNK_TILE_CELLS);
+        file.read(reinterpret_cast<char *>(it->second.cells.data()), CHUNK_TILE_CELLS);
+    }
+
+    last_tile = tile;
+    last = &it->second;
+    return *last;
+}
+
+int64_t ChunkedMaze::get_neighbor(int64_t cell, int slot) const {
+    auto i = cell / height;
+    auto j = cell % height;
+    int64_t ni;
+    int64_t nj;
+    switch (type) {
+        case GraphType::ORTHOGONAL:
+            if (slot >= Lattice<GraphType::ORTHOGONAL>::DEGREE)
+                return -1;
+            ni = i + Lattice<GraphType::ORTHOGONAL>::DI[slot];
+            nj = j + Lattice<GraphType::ORTHOGONAL>::DJ_EVEN[slot];
+            break;
+        case GraphType::HEXAGONAL:
+            if (slot >= Lattice<GraphType::HEXAGONAL>::DEGREE)
+                return -1;
+            ni = i + Lattice<GraphType::HEXAGONAL>::DI[slot];
+            nj = j + (i % 2 == 0 ? Lattice<GraphType::HEXAGONAL>::DJ_EVEN[slot]
+                                 : Lattice<GraphType::HEXAGONAL>::DJ_ODD[slot]);
+            break;
+        default:
+            ni = i + Lattice<GraphType::LAPLACIAN>::DI[slot];
+            nj = j + Lattice<GraphType::LAPLACIAN>::DJ_EVEN[slot];
+            break;
+    }
+
+    if (ni < 0 || ni >= width || nj < 0 || nj >= height)
+        return -1;
+    return ni * height + nj;
+}
+
+uint8_t ChunkedMaze::get_open_mask(int64_t cell) {
+    int64_t offset;
+    auto tile = locate(cell, offset);
+    return get_tile(tile).cells[offset];
+}
+
+void ChunkedMaze::open_slot(int64_t cell, int slot) {
+    auto neighbor = get_neighbor(cell, slot);
+    int64_t offset;
+    auto &first = get_tile(locate(cell, offset));
+    first.cells[offset] |= 1 << slot;
+    first.dirty = true;
+    auto &second = get_tile(locate(neighbor, offset));
+    second.cells[offset] |= 1 << (slot ^ 1); // Lattice slots come in pairs of opposite directions
+    second.dirty = true;
+}
+
+void ChunkedMaze::close_slot(int64_t cell, int slot) {
+    auto neighbor = get_neighbor(cell, slot);
+    int64_t offset;
+    auto &first = get_tile(locate(cell, offset));
+    first.cells[offset] &= ~(1 << slot);
+    first.dirty = true;
+    auto &second = get_tile(locate(neighbor, offset));
+    second.cells[offset] &= ~(1 << (slot ^ 1));
+    second.dirty = true;
+}
+
+bool ChunkedMaze::flush() {
+    for (auto &[index, tile]: tiles) {
+        if (tile.dirty) {
+            write_tile(index, tile.cells);
+            tile.dirty = false;
+        }
+    }
+    file.clear(); // Reads past the end of the file (tiles never written) leave the fail flag set
+    if (!file.flush() && !write_failed) {
+        std::cerr << "Could not write into the maze file, changes of the maze are lost\n";
+        write_failed = true;
+    }
+    return !write_failed;
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <list>
+#include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+#include "lattice.h"
+
+/** Width and height of a tile in cells */
+constexpr int64_t CHUNK_TILE_SIZE = 256;
+
+/**
+ * Maze on a lattice stored out-of-core
+ * Cells have 64-bit ids (v = i * height + j, same as Graph), their open slot masks are split
+ * into square tiles kept in a backing file, only the least recently used tiles are cached in memory
+ * Tiles never written read as all walls (the backing file is sparse)
+ * The backing file starts with a small header (size and lattice type), so a maze can be opened again later
+ */
+class ChunkedMaze {
+private:
+    /**
+     * Cached tile
+     */
+    struct Tile {
+        /** Open slot masks of the cells of the tile (column-major) */
+        std::vector<uint8_t> cells;
+        /** True if the tile changed since it was loaded */
+        bool dirty;
+        /** Position of the tile in the LRU list */
+        std::list<int64_t>::iterator position;
+    };
+
+    /** Width of the maze */
+    int64_t width;
+    /** Height of the maze */
+    int64_t height;
+    /** Lattice type */
+    GraphType type;
+    /** Number of tile rows */
+    int64_t tiles_y;
+    /** Maximal number of cached tiles */
+    size_t capacity;
+    /** Backing file */
+    std::fstream file;
+    /** Cached tiles by tile index */
+    std::unordered_map<int64_t, Tile> tiles;
+    /** Tile indices from the most to the least recently used */
+    std::list<int64_t> lru;
+    /** Index of the last accessed tile (-1 if none) */
+    int64_t last_tile;
+    /** Last accessed tile (cached tiles do not move in memory) */
+    Tile *last;
+    /** True if some tile could not be written into the backing file */
+    bool write_failed;
+
+    /**
+     * Gets the tile, loads it from the backing file if it is not cached (evicting the least recently used one)
+     * @param tile Tile index
+     * @return Tile
+     */
+    Tile &get_tile(int64_t tile);
+
+    /**
+     * Writes the tile into the backing file
+     * @param tile Tile index
+     * @param cells Cells of the tile
+     */
+    void write_tile(int64_t tile, const std::vector<uint8_t> &cells);
+
+    /**
+     * Finds the tile of a cell
+     * @param cell Cell id
+     * @param offset Position of the cell inside the tile (output)
+     * @return Tile index
+     */
+    [[nodiscard]] int64_t locate(int64_t cell, int64_t &offset) const;
+
+public:
+    /**
+     * Constructor, creates a new (empty) backing file (an existing file is overwritten)
+     * Prints an error if the file can not be created (see is_open)
+     * @param filename Name of the backing file
+     * @param type Lattice type
+     * @param width Width of the maze
+     * @param height Height of the maze
+     * @param capacity Maximal number of tiles cached in memory (at least 2)
+     */
+    ChunkedMaze(const std::string &filename, GraphType type, int64_t width, int64_t height, size_t capacity = 1024);
+
+    /**
+     * Constructor, opens an existing backing file (the size and the lattice type are read from its header)
+     * Prints an error if the file can not be opened or is not a backing file of a maze (see is_open)
+     * @param filename Name of the backing file
+     * @param capacity Maximal number of tiles cached in memory (at least 2)
+     */
+    explicit ChunkedMaze(const std::string &filename, size_t capacity = 1024);
+
+    /**
+     * Destructor, writes the changed tiles into the backing file
+     */
+    ~ChunkedMaze();
+
+    /**
+     * Checks if the backing file is usable
+     * @return True if the backing file was opened (and has a valid header), false otherwise
+     */
+    [[nodiscard]] bool is_open() const;
+
+    /**
+     * Getter for width
+     * @return Width of the maze
+     */
+    [[nodiscard]] int64_t get_width() const;
+
+    /**
+     * Getter for height
+     * @return Height of the maze
+     */
+    [[nodiscard]] int64_t get_height() const;
+
+    /**
+     * Getter for cell count
+     * @return Number of cells
+     */
+    [[nodiscard]] int64_t get_v() const;
+
+    /**
+     * Getter for lattice type
+     * @return Lattice type
+     */
+    [[nodiscard]] GraphType get_type() const;
+
+    /**
+     * Getter for the neighbor in the given slot
+     * @param cell Cell id
+     * @param slot Slot
+     * @return Cell id of the neighbor, -1 if the slot leads out of the maze
+     */
+    [[nodiscard]] int64_t get_neighbor(int64_t cell, int slot) const;
+
+    /**
+     * Getter for the open slots of a cell
+     * @param cell Cell id
+     * @return Bitmask, bit k is set if the edge in slot k is open
+     */
+    [[nodiscard]] uint8_t get_open_mask(int64_t cell);
+
+    /**
+     * Opens the edge in the given slot (in both directions)
+     * @param cell Cell id
+     * @param slot Slot of the edge (must lead to a neighbor)
+     */
+    void open_slot(int64_t cell, int slot);
+
+    /**
+     * Closes the edge in the given slot (in both directions)
+     * @param cell Cell id
+     * @param slot Slot of the edge (must lead to a neighbor)
+     */
+    void close_slot(int64_t cell, int slot);
+
+    /**
+     * Writes all the changed tiles into the backing file
+     * @return True if every tile written since the file was opened got into the file, false otherwise
+     */
+    bool flush();
+};
@@ -0,0 +1,56 @@
+#include "concurrent_disjoint_union_sets.h"
+
+Concurrent_disjoint_union_sets::Concurrent_disjoint_union_sets(int size) : size{0} {
+    reset(size);
+}
+
+int Concurrent_disjoint_union_sets::find(int x) {
+    while (true) {
+        auto p = parent[x].load(std::memory_order_acquire);
+        if (p == x)
+            return x;
+
+        // Path halving, a failed swap only means another thread changed the parent first
+        auto grandparent = parent[p].load(std::memory_order_acquire);
+        if (p != grandparent)
+            parent[x].compare_exchange_weak(p, grandparent, std::memory_order_release, std::memory_order_relaxed);
+        x = grandparent;
+    }
+}
+
+bool Concurrent_disjoint_union_sets::merge(int x, int y) {
+    while (true) {
+        x = find(x);
+        y = find(y);
+        if (x == y)
+            return false;
+
+        // Link the larger root under the smaller one, retry if the root got linked meanwhile
+        if (x < y)
+            std::swap(x, y);
+        auto expected = x;
+        if (parent[x].compare_exchange_strong(expected, y, std::memory_order_acq_rel))
+            return true;
+    }
+}
+
+bool Concurrent_disjoint_union_sets::same_set(int x, int y) {
+    while (true) {
+        x = find(x);
+        y = find(y);
+        if (x == y)
+            return true;
+        // Different roots are only an answer if x is still a root (it was not linked in the meantime)
+        if (parent[x].load(std::memory_order_acquire) == x)
+            return false;
+    }
+}
+
+void Concurrent_disjoint_union_sets::reset(int new_size) {
+    if (new_size != -1 && new_size != size) {
+        size = new_size;
+        parent = std::make_unique<std::atomic<int>[]>(size);
+    }
+    for (int i = 0; i < size; i++)
+        parent[i].store(i, std::memory_order_relaxed);
+}
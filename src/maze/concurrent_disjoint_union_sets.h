@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+/**
+ * Lock-free disjoint union sets, find and merge can be called from several threads at once
+ * Parents are updated with compare-and-swap, roots are linked by index (the larger index goes under the smaller one,
+ * so the parent links can never form a cycle) and find halves the paths it walks
+ */
+class Concurrent_disjoint_union_sets {
+private:
+    /** Parent of each element (roots are their own parents) */
+    std::unique_ptr<std::atomic<int>[]> parent;
+    /** Size of the whole data structure */
+    int size;
+
+public:
+    /**
+     * Constructor
+     * @param size Size of the data structure
+     */
+    explicit Concurrent_disjoint_union_sets(int size);
+
+    /**
+     * Find the root of the set of the given element
+     * (the root can change while other threads merge, same_set gives a consistent answer)
+     * @param x Element
+     * @return Root of the set of the element
+     */
+    int find(int x);
+
+    /**
+     * Merge two elements
+     * @param x Element
+     * @param y Element
+     * @return True if this call merged two different sets, false if the elements were in the same set already
+     */
+    bool merge(int x, int y);
+
+    /**
+     * Checks if two elements are in the same set
+     * @param x Element
+     * @param y Element
+     * @return True if the elements are in the same set, false otherwise
+     */
+    bool same_set(int x, int y);
+
+    /**
+     * Makes every element a set of its own again (must not run together with other calls)
+     * @param new_size New size of the data structure (-1 to keep the current one)
+     */
+    void reset(int new_size = -1);
+};
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+
+/**
+ * Fixed size array split into copy-on-write pages
+ * Copies of the array share all the pages, a page is cloned on the first write into it
+ * while it is shared, so keeping older copies costs memory of the changed pages only
+ * @tparam T Element type
+ * @tparam PAGE_BITS Base 2 logarithm of the number of elements in one page
+ */
+template<typename T, int PAGE_BITS = 12>
+class CowArray {
+private:
+    /** Number of elements in one page */
+    static constexpr size_t PAGE_SIZE = size_t{1} << PAGE_BITS;
+    /** Mask of the position inside a page */
+    static constexpr size_t PAGE_MASK = PAGE_SIZE - 1;
+
+    /** Number of elements */
+    size_t length;
+    /** Pages (the last one can be used partially) */
+    std::vector<std::shared_ptr<T[]>> pages;
+    /** Owner of external memory the pages point into (holding it keeps those pages shared, so they are never written) */
+    std::shared_ptr<const void> backing;
+
+    /**
+     * Makes sure the page is not shared with any other array before writing into it
+     * @param page Page index
+     * @return Pointer to the page data
+     */
+    T *make_page_unique(size_t page) {
+        if (pages[page].use_count() > 1) {
+            auto copy = std::make_shared_for_overwrite<T[]>(PAGE_SIZE);
+            auto count = std::min(PAGE_SIZE, length - (page << PAGE_BITS)); // External memory ends with the last element
+            std::copy(pages[page].get(), pages[page].get() + count, copy.get());
+            pages[page] = std::move(copy);
+        }
+        return pages[page].get();
+    }
+
+public:
+    /**
+     * Constructor of an empty array
+     */
+    CowArray() : length{0} {
+        // Nothing to do here :)
+    }
+
+    /**
+     * Constructor
+     * @param length Number of elements
+     * @param value Initial value of all the elements
+     */
+    CowArray(size_t length, T value) : length{length}, pages((length + PAGE_MASK) >> PAGE_BITS) {
+        for (auto &page: pages) {
+            page = std::make_shared_for_overwrite<T[]>(PAGE_SIZE);
+            std::fill(page.get(), page.get() + PAGE_SIZE, value);
+        }
+    }
+
+    /**
+     * Constructor of an array viewing external memory (for example a memory mapped file)
+     * The memory is never written, pages are cloned on the first write into them
+     * @param data Pointer to the elements
+     * @param length Number of elements
+     * @param owner Owner of the memory (kept alive as long as any page points into it)
+     */
+    CowArray(const T *data, size_t length, std::shared_ptr<const void> owner)
+            : length{length}, pages((length + PAGE_MASK) >> PAGE_BITS), backing{std::move(owner)} {
+        for (size_t page = 0; page < pages.size(); page++)
+            pages[page] = std::shared_ptr<T[]>(backing, const_cast<T *>(data) + (page << PAGE_BITS));
+    }
+
+    /**
+     * Getter for length
+     * @return Number of elements
+     */
+    [[nodiscard]] size_t size() const {
+        return length;
+    }
+
+    /**
+     * Read access to an element
+     * @param index Index of the element
+     * @return Element
+     */
+    const T &operator[](size_t index) const {
+        return pages[index >> PAGE_BITS][index & PAGE_MASK];
+    }
+
+    /**
+     * Write access to an element (clones the page of the element if it is shared)
+     * @param index Index of the element
+     * @return Reference to the element
+     */
+    T &at_mut(size_t index) {
+        return make_page_unique(index >> PAGE_BITS)[index & PAGE_MASK];
+    }
+
+    /**
+     * Copies a run of elements out of the array page by page
+     * @param first Index of the first read element
+     * @param values Values of the run (output)
+     * @param count Number of elements of the run
+     */
+    void read(size_t first, T *values, size_t count) const {
+        while (count > 0) {
+            auto offset = first & PAGE_MASK;
+            auto run = std::min(count, PAGE_SIZE - offset);
+            std::copy(pages[first >> PAGE_BITS].get() + offset, pages[first >> PAGE_BITS].get() + offset + run, values);
+            first += run;
+            values += run;
+            count -= run;
+        }
+    }
+
+    /**
+     * Copies a run of elements into the array page by page (clones only the shared pages the run touches)
+     * Writes into distinct elements of unique pages can run concurrently
+     * @param first Index of the first written element
+     * @param values Values of the run
+     * @param count Number of elements of the run
+     */
+    void write(size_t first, const T *values, size_t count) {
+        while (count > 0) {
+            auto offset = first & PAGE_MASK;
+            auto run = std::min(count, PAGE_SIZE - offset);
+            std::copy(values, values + run, make_page_unique(first >> PAGE_BITS) + offset);
+            first += run;
+            values += run;
+            count -= run;
+        }
+    }
+
+    /**
+     * Overwrites the elements with the ones of another array of the same length
+     * Pages of this array that are not shared are reused, so copying between arrays with their own pages allocates nothing
+     * @param other Array to copy
+     */
+    void copy_from(const CowArray &other) {
+        for (size_t page = 0; page < pages.size(); page++) {
+            if (pages[page] == other.pages[page]) // Same page, same content
+                continue;
+            if (pages[page].use_count() > 1) // No need to copy the old content
+                pages[page] = std::make_shared_for_overwrite<T[]>(PAGE_SIZE);
+            auto count = std::min(PAGE_SIZE, length - (page << PAGE_BITS));
+            std::copy(other.pages[page].get(), other.pages[page].get() + count, pages[page].get());
+        }
+    }
+
+    /**
+     * Sets all the elements to the given value
+     * @param value New value of all the elements
+     */
+    void fill(T value) {
+        for (size_t page = 0; page < pages.size(); page++) {
+            if (pages[page].use_count() > 1) // No need to copy the old content
+                pages[page] = std::make_shared_for_overwrite<T[]>(PAGE_SIZE);
+            std::fill(pages[page].get(), pages[page].get() + PAGE_SIZE, value);
+        }
+    }
+
+    /**
+     * Makes all the pages unique (after that, writes into distinct pages can run concurrently)
+     */
+    void make_unique() {
+        for (size_t page = 0; page < pages.size(); page++)
+            make_page_unique(page);
+    }
+};
@@ -1,35 +1,45 @@
 #include "disjoint_union_sets.h"
 
-Disjoint_union_sets::Disjoint_union_sets(int size) {
-    this->size = size;
-    parent.resize(size);
-    rank.resize(size);
-    for (int i = 0; i < size; i++) {
-        parent[i] = i;
-        rank[i] = 0;
-    }
+Disjoint_union_sets::Disjoint_union_sets(int size) : size{0} {
+    reset(size);
 }
 
 int Disjoint_union_sets::find(int x) {
-    if (parent[x] != x)
-        parent[x] = find(parent[x]);
-    return parent[x];
+    // Path halving, every other element on the path skips its parent
+    while (true) {
+        auto p = parent[x];
+        if (p < 0)
+            return x;
+        auto grandparent = parent[p];
+        if (grandparent < 0)
+            return p;
+        parent[x] = grandparent;
+        x = grandparent;
+    }
 }
 
-void Disjoint_union_sets::merge(int x, int y) {
+bool Disjoint_union_sets::merge(int x, int y) {
     int x_root = find(x);
     int y_root = find(y);
 
     // Elements are already in the same set
     if (x_root == y_root)
-        return;
+        return false;
 
-    if (rank[x_root] < rank[y_root])
-        parent[x_root] = y_root;
-    else if (rank[x_root] > rank[y_root])
-        parent[y_root] = x_root;
-    else {
-        parent[y_root] = x_root;
-        rank[x_root]++;
-    }
+    // The smaller set goes under the bigger one (sizes are negated)
+    if (parent[x_root] > parent[y_root])
+        std::swap(x_root, y_root);
+    parent[x_root] += parent[y_root];
+    parent[y_root] = x_root;
+    return true;
+}
+
+int Disjoint_union_sets::get_set_size(int x) {
+    return -parent[find(x)];
+}
+
+void Disjoint_union_sets::reset(int new_size) {
+    if (new_size != -1)
+        size = new_size;
+    parent.assign(size, -1);
 }
@@ -1,16 +1,17 @@
 #pragma once
 
 #include <vector>
+#include <utility>
 
 /**
  * Disjoint union sets data structure
+ * Union by size and iterative find with path halving, parents and sizes share one vector
+ * (roots keep their negated set size, other elements keep their parent)
  */
 class Disjoint_union_sets {
 private:
-    /** Parent of each element */
+    /** Parent of each element (negated size of the set for roots) */
     std::vector<int> parent;
-    /** Rank of each element */
-    std::vector<int> rank;
     /** Size of the whole data structure */
     int size;
 
@@ -32,6 +33,20 @@ public:
      * Merge two elements
      * @param x Element
      * @param y Element
+     * @return True if the elements were in different sets, false otherwise
      */
-    void merge(int x, int y);
+    bool merge(int x, int y);
+
+    /**
+     * Getter for the size of the set of an element
+     * @param x Element
+     * @return Number of elements of the set
+     */
+    int get_set_size(int x);
+
+    /**
+     * Makes every element a set of its own again (keeps the allocated memory)
+     * @param new_size New size of the data structure (-1 to keep the current one)
+     */
+    void reset(int new_size = -1);
 };
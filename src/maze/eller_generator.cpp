@@ -0,0 +1,84 @@
+#include "eller_generator.h"
+
+EllerGenerator::EllerGenerator(int width, float horizontal_bias, float vertical_bias, uint64_t seed)
+        : width{width}, horizontal_bias{horizontal_bias}, vertical_bias{vertical_bias}, row{0}, sets(width, -1),
+          parent(width), masks(width, 0), finished(width, 0), chosen(width), seen(width),
+          gen(seed, RandomStream::GENERATOR), dis(0.0f, 1.0f) {
+    // Nothing to do here :)
+}
+
+int EllerGenerator::find(int label) {
+    while (parent[label] != label) {
+        parent[label] = parent[parent[label]];
+        label = parent[label];
+    }
+    return label;
+}
+
+const std::vector<uint8_t> &EllerGenerator::next_row(bool last) {
+    // Cells not connected from above get the labels no other cell of the row uses (there are always enough of them)
+    std::fill(seen.begin(), seen.end(), 0);
+    for (auto label: sets)
+        if (label != -1)
+            seen[label] = 1;
+    auto free_label = 0;
+    for (auto &label: sets) {
+        if (label == -1) {
+            while (seen[free_label])
+                free_label++;
+            label = free_label++;
+        }
+    }
+    for (int i = 0; i < width; i++)
+        parent[i] = i;
+
+    // Join horizontally adjacent cells of different sets (all of them in the last row)
+    for (int i = 0; i + 1 < width; i++) {
+        auto a = find(sets[i]);
+        auto b = find(sets[i + 1]);
+        if (a != b && (last || dis(gen) < horizontal_bias)) {
+            masks[i] |= 1 << 1;
+            masks[i + 1] |= 1 << 0;
+            parent[a] = b;
+        }
+    }
+    for (auto &label: sets)
+        label = find(label);
+
+    finished.swap(masks);
+    std::fill(masks.begin(), masks.end(), 0);
+    row++;
+    if (last)
+        return finished;
+
+    // Downward passages, every set gets at least one (a uniformly chosen cell if none was drawn)
+    std::fill(seen.begin(), seen.end(), 0);
+    std::fill(chosen.begin(), chosen.end(), -1);
+    for (int i = 0; i < width; i++) {
+        auto label = sets[i];
+        if (dis(gen) < vertical_bias) {
+            chosen[label] = -2; // Set already has a passage
+            masks[i] = 1 << 2;
+        } else if (chosen[label] != -2 && std::uniform_int_distribution<int>(0, seen[label])(gen) == 0) {
+            chosen[label] = i;
+        }
+        seen[label]++;
+    }
+    for (int i = 0; i < width; i++)
+        if (chosen[sets[i]] == i)
+            masks[i] = 1 << 2;
+
+    // Cells without a downward passage start new sets in the next row
+    for (int i = 0; i < width; i++) {
+        if (masks[i]) // Passage up from the next row
+            finished[i] |= 1 << 3;
+        else
+            sets[i] = -1;
+    }
+
+    return finished;
+}
+
+int64_t EllerGenerator::get_row() const {
+    return row;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+#include <random>
+#include <cstdint>
+#include "philox.h"
+
+/**
+ * Row streaming maze generator (Eller's algorithm) on an orthogonal lattice
+ * Only the set labels of the current row are kept, so the memory is O(width) for any height
+ * Rows are returned as open slot masks (0 left, 1 right, 2 up, 3 down) as soon as they are final
+ */
+class EllerGenerator {
+private:
+    /** Width of the maze */
+    int width;
+    /** Probability of joining two horizontally adjacent cells of different sets */
+    float horizontal_bias;
+    /** Probability of an extra downward passage (every set always gets at least one) */
+    float vertical_bias;
+    /** Index of the next row */
+    int64_t row;
+    /** Set label of every cell of the current row (-1 if the cell is not connected from above) */
+    std::vector<int> sets;
+    /** Parents of the set labels while joining the current row */
+    std::vector<int> parent;
+    /** Open slot masks of the current row */
+    std::vector<uint8_t> masks;
+    /** Open slot masks of the returned row */
+    std::vector<uint8_t> finished;
+    /** Cells chosen for the downward passage of every set */
+    std::vector<int> chosen;
+    /** Number of cells of every set seen so far (for choosing uniformly) */
+    std::vector<int> seen;
+    /** Random number generator */
+    Philox gen;
+    /** Uniform distribution on [0, 1) */
+    std::uniform_real_distribution<float> dis;
+
+    /**
+     * Finds the representative of a set label
+     * @param label Set label
+     * @return Representative label
+     */
+    int find(int label);
+
+public:
+    /**
+     * Constructor
+     * @param width Width of the maze
+     * @param horizontal_bias Probability of joining two horizontally adjacent cells of different sets
+     * @param vertical_bias Probability of an extra downward passage
+     * @param seed Seed
+     */
+    EllerGenerator(int width, float horizontal_bias = 0.5f, float vertical_bias = 0.5f, uint64_t seed = 0);
+
+    /**
+     * Generates the next row
+     * @param last True if the row is the last one (all the sets are joined, no downward passages)
+     * @return Open slot masks of the cells of the row (valid until the next call)
+     */
+    const std::vector<uint8_t> &next_row(bool last = false);
+
+    /**
+     * Getter for row
+     * @return Index of the next row
+     */
+    [[nodiscard]] int64_t get_row() const;
+};
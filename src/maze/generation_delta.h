@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+
+/**
+ * Changes of a graph between two generations of a Cellular Automata
+ * Edges are listed once, as pairs of node indices with the smaller index first
+ */
+struct GenerationDelta {
+    /** Nodes that became alive */
+    std::vector<int> born;
+    /** Nodes that died */
+    std::vector<int> died;
+    /** Edges that were opened */
+    std::vector<std::pair<int, int>> opened;
+    /** Edges that were closed */
+    std::vector<std::pair<int, int>> closed;
+
+    /**
+     * Checks if nothing changed
+     * @return True if the delta is empty, false otherwise
+     */
+    [[nodiscard]] bool empty() const {
+        return born.empty() && died.empty() && opened.empty() && closed.empty();
+    }
+
+    /**
+     * Clears the delta (keeps the allocated memory)
+     */
+    void clear() {
+        born.clear();
+        died.clear();
+        opened.clear();
+        closed.clear();
+    }
+};
@@ -1,133 +1,154 @@
 #include "generator.h"
+#include <cmath>
+#include <fstream>
 
-std::shared_ptr<Graph> Generator::create_orthogonal_grid_graph(int width, int height, bool non_grid) {
-    auto grid_graph = std::make_shared<Graph>(width, height);
-    std::default_random_engine gen(std::chrono::system_clock::now().time_since_epoch().count());
-    std::normal_distribution<> dis(0, 1);
+/** Number of nodes from which grid graphs are built by several threads (smaller ones are not worth the threads) */
+constexpr int PARALLEL_BUILD_NODES = 1 << 18;
 
-    for (int i = 0; i < width; i++) {
-        for (int j = 0; j < height; j++) {
-            int v = i * height + j;
-            int x = i * GRID_SIZE + GRID_SIZE;
-            int y = j * GRID_SIZE + GRID_SIZE;
-            if (non_grid) { // add some noise
-                x += static_cast<int>(dis(gen) * GRID_SIZE / 8);
-                y += static_cast<int>(dis(gen) * GRID_SIZE / 8);
-            }
-            grid_graph->set_node(v, x, y);
+/**
+ * Computes the noise of one coordinate, approximately normal (Irwin-Hall sum of four uniform 16-bit numbers)
+ * The sum has the mean of 131070 and the standard deviation of 37837, the noise never exceeds 3.47 deviations
+ * @param a First random number
+ * @param b Second random number
+ * @param scale Standard deviation of the noise divided by the one of the sum
+ * @return Noise in pixels
+ */
+inline int coordinate_noise(uint32_t a, uint32_t b, float scale) {
+    auto sum = static_cast<int>((a & 0xFFFF) + (a >> 16) + (b & 0xFFFF) + (b >> 16));
+    return static_cast<int>(static_cast<float>(sum - 131070) * scale);
+}
 
-            if (i > 0)
-                grid_graph->add_edge(v, (i - 1) * height + j);
-            if (j > 0)
-                grid_graph->add_edge(v, i * height + j - 1);
-        }
+/**
+ * Computes the noisy positions of one lattice column
+ * Every node has its own counter-based block, so the noise does not depend on the order of the nodes,
+ * and the loop has no branches, so it vectorizes
+ * @param seed Seed of the noise
+ * @param first Node index of the first node of the column
+ * @param height Number of nodes of the column
+ * @param x X coordinate of the column
+ * @param y Y coordinate of the first node of the column
+ * @param grid_size Distance of two neighboring nodes in pixels
+ * @param xs X coordinates of the column (output)
+ * @param ys Y coordinates of the column (output)
+ */
+void fill_noisy_column(uint64_t seed, int first, int height, int x, int y, int grid_size, int *xs, int *ys) {
+    auto scale = static_cast<float>(grid_size) / (8.0f * 37837.0f); // Standard deviation of grid_size / 8
+    auto stream = static_cast<uint64_t>(RandomStream::JITTER);
+    for (int j = 0; j < height; j++) {
+        auto block = Philox::generate(seed, stream, static_cast<uint64_t>(first + j));
+        xs[j] = x + coordinate_noise(block[0], block[1], scale);
+        ys[j] = y + j * grid_size + coordinate_noise(block[2], block[3], scale);
     }
-
-    return grid_graph;
 }
 
-std::shared_ptr<Graph> Generator::create_hexagonal_grid_graph(int width, int height, bool non_grid) {
-    auto grid_graph = std::make_shared<Graph>(width, height);
-    std::default_random_engine gen(std::chrono::system_clock::now().time_since_epoch().count());
-    std::normal_distribution<> dis(0, 1);
+/**
+ * Creates a grid graph with an implicit lattice topology
+ * Everything is allocated once up front, then the columns are filled independently
+ * (in parallel for big grids if the caller asks for more than one thread)
+ * @tparam TYPE Lattice type
+ * @param width Width of the grid
+ * @param height Height of the grid
+ * @param non_grid Non-grid flag (positions are stored with some noise instead of being computed)
+ * @param seed Seed of the noise
+ * @param threads Number of threads (0 for the number of hardware threads, 1 on the calling thread)
+ * @return Grid graph
+ */
+template<GraphType TYPE>
+std::shared_ptr<Graph> create_lattice_graph(int width, int height, bool non_grid, uint64_t seed, unsigned threads) {
+    std::vector<int> xs(non_grid ? width * height : 0);
+    std::vector<int> ys(non_grid ? width * height : 0);
+    // All edges start open, the masks come straight from the compile-time offsets of the lattice
+    CowArray<uint8_t> open(width * height, 0);
 
-    for (int i = 0; i < width; i++) {
-        for (int j = 0; j < height; j++) {
-            int v = i * height + j;
-            int x = i * GRID_SIZE + GRID_SIZE;
-            int y = j * GRID_SIZE + GRID_SIZE;
-            if (i % 2 == 1)
-                y += GRID_SIZE / 2;
-            if (non_grid) { // add some noise
-                x += static_cast<int>(dis(gen) * GRID_SIZE / 8);
-                y += static_cast<int>(dis(gen) * GRID_SIZE / 8);
-            }
-            grid_graph->set_node(v, x, y);
-
-            if (i > 0)
-                grid_graph->add_edge(v, (i - 1) * height + j);
-            if (j > 0)
-                grid_graph->add_edge(v, i * height + j - 1);
-            if (i > 0 && j > 0 && i % 2 == 0)
-                grid_graph->add_edge(v, (i - 1) * height + j - 1);
-            if (i > 0 && j < height - 1 && i % 2 == 1)
-                grid_graph->add_edge(v, (i - 1) * height + j + 1);
-        }
+    // Size is captured by value, so the writes into the columns cannot alias it and the loops vectorize
+    auto fill_column = [&, width, height](int64_t column) {
+        auto i = static_cast<int>(column);
+        auto first = i * height;
+        std::vector<uint8_t> masks(height);
+        for (int j = 0; j < height; j++)
+            masks[j] = Lattice<TYPE>::slot_mask(i, j, width, height);
+        open.write(first, masks.data(), height); // Fresh pages are unique, so the columns can be written concurrently
+
+        if (non_grid) // add some noise to the positions the topology would compute
+            fill_noisy_column(seed, first, height, i * GRID_SIZE + GRID_SIZE,
+                              GRID_SIZE + (TYPE == GraphType::HEXAGONAL && i % 2 == 1 ? GRID_SIZE / 2 : 0), GRID_SIZE,
+                              xs.data() + first, ys.data() + first);
+    };
+    if (threads != 1 && width * height >= PARALLEL_BUILD_NODES) {
+        ThreadPool pool(threads);
+        pool.parallel_for(width, fill_column);
+    } else {
+        for (int i = 0; i < width; i++)
+            fill_column(i);
     }
 
-    return grid_graph;
+    return std::make_shared<Graph>(std::make_shared<Topology>(width, height, TYPE, GRID_SIZE, std::move(xs),
+                                                              std::move(ys)), std::move(open),
+                                   CowArray<uint64_t>((width * height + 63) / 64, ~0ull));
 }
 
-std::shared_ptr<Graph> Generator::create_orthogonal_grid_graph_laplacian(int width, int height, bool non_grid) {
-    auto grid_graph = std::make_shared<Graph>(width, height);
-    std::default_random_engine gen(std::chrono::system_clock::now().time_since_epoch().count());
-    std::normal_distribution<> dis(0, 1);
+std::shared_ptr<Graph>
+Generator::create_orthogonal_grid_graph(int width, int height, bool non_grid, uint64_t seed, unsigned threads) {
+    return create_lattice_graph<GraphType::ORTHOGONAL>(width, height, non_grid, seed, threads);
+}
 
-    for (int i = 0; i < width; i++) {
-        for (int j = 0; j < height; j++) {
-            int v = i * height + j;
-            int x = i * GRID_SIZE + GRID_SIZE;
-            int y = j * GRID_SIZE + GRID_SIZE;
-            if (non_grid) { // add some noise
-                x += static_cast<int>(dis(gen) * GRID_SIZE / 8);
-                y += static_cast<int>(dis(gen) * GRID_SIZE / 8);
-            }
-            grid_graph->set_node(v, x, y);
-
-            if (i > 0)
-                grid_graph->add_edge(v, (i - 1) * height + j);
-            if (j > 0)
-                grid_graph->add_edge(v, i * height + j - 1);
-            if (i > 0 && j > 0)
-                grid_graph->add_edge(v, (i - 1) * height + j - 1);
-            if (i > 0 && j < height - 1)
-                grid_graph->add_edge(v, (i - 1) * height + j + 1);
-        }
-    }
+std::shared_ptr<Graph>
+Generator::create_hexagonal_grid_graph(int width, int height, bool non_grid, uint64_t seed, unsigned threads) {
+    return create_lattice_graph<GraphType::HEXAGONAL>(width, height, non_grid, seed, threads);
+}
 
-    return grid_graph;
+std::shared_ptr<Graph>
+Generator::create_orthogonal_grid_graph_laplacian(int width, int height, bool non_grid, uint64_t seed,
+                                                  unsigned threads) {
+    return create_lattice_graph<GraphType::LAPLACIAN>(width, height, non_grid, seed, threads);
 }
 
-std::shared_ptr<Graph> Generator::generate_maze_dfs(std::shared_ptr<Graph> &maze) {
-    std::default_random_engine gen(std::chrono::system_clock::now().time_since_epoch().count());
+/**
+ * Carves a maze into the graph with randomized depth first search
+ * @param maze Graph, its open edges are the edges that can be carved
+ * @param gen Random number generator
+ */
+void carve_dfs(const std::shared_ptr<Graph> &maze, Philox &gen) {
     std::uniform_int_distribution<> dis(0, RAND_MAX);
 
-    auto to_be_removed_paths = maze->create_copy();
+    // Edges that can be carved (snapshot of the base graph), the maze starts with walls everywhere
+    auto base = maze->create_copy();
+    maze->close_all_edges();
+    auto &topology = maze->get_topology();
 
-    std::vector<int> stack;
-    std::vector<bool> visited(maze->get_v(), false);
+    // Slot leading back to the parent of every visited node, following them from the current node is the DFS stack
+    constexpr uint8_t UNVISITED = 0xFF;
+    constexpr uint8_t ROOT = 0xFE;
+    std::vector<uint8_t> parent_slot(maze->get_v(), UNVISITED);
     int current = 0;
-    stack.push_back(current);
-    visited[current] = true;
-
-    while (!stack.empty()) {
-        std::vector<int> neighbors;
-        for (int i: to_be_removed_paths->get_adj()[current])
-            if (!visited[i])
-                neighbors.push_back(i);
+    parent_slot[current] = ROOT;
 
-        if (neighbors.empty()) {
-            stack.pop_back();
-            if (!stack.empty())
-                current = stack.back();
-
-        } else {
-            int random_neighbor = neighbors[dis(gen) % neighbors.size()];
-            to_be_removed_paths->remove_edge(current, random_neighbor);
-            stack.push_back(random_neighbor);
-            current = random_neighbor;
-            visited[current] = true;
+    while (true) {
+        int slots[MAX_DEGREE];
+        auto count = 0;
+        for (unsigned mask = base->get_open_mask(current); mask; mask &= mask - 1) {
+            auto slot = std::countr_zero(mask);
+            if (parent_slot[topology->get_neighbor(current, slot)] == UNVISITED)
+                slots[count++] = slot;
         }
-    }
 
-    for (int i = 0; i < maze->get_v(); i++) {
-        for (int j = 0; j < maze->get_v(); j++) {
-            if (to_be_removed_paths->is_adjacent(i, j)) {
-                maze->remove_edge(i, j);
-            }
+        if (count == 0) { // Backtrack
+            if (parent_slot[current] == ROOT)
+                break;
+            current = topology->get_neighbor(current, parent_slot[current]);
+        } else { // Carve the passage into a random unvisited neighbor
+            auto slot = slots[dis(gen) % count];
+            auto next = topology->get_neighbor(current, slot);
+            maze->open_slot(current, slot);
+            parent_slot[next] = topology->get_reverse_slot(current, slot);
+            current = next;
         }
     }
+}
 
+std::shared_ptr<Graph> Generator::generate_maze_dfs(std::shared_ptr<Graph> &maze, uint64_t seed) {
+    Philox gen(seed, RandomStream::GENERATOR);
+    carve_dfs(maze, gen);
     return maze;
 }
 
@@ -143,124 +164,384 @@ bool is_horizontal(int x1, int y1, int x2, int y2) {
     return abs(x1 - x2) > abs(y1 - y2);
 }
 
-std::shared_ptr<Graph>
-Generator::generate_maze_kruskal(std::shared_ptr<Graph> &maze, float horizontal_bias, float vertical_bias,
-                                 float cycle_bias) {
+/**
+ * Carves a maze into the graph with Kruskal's modified algorithm
+ * @param maze Graph, its open edges are the edges that can be carved
+ * @param horizontal_bias Horizontal bias (share of the horizontal edges, normalized by the sum of the biases)
+ * @param vertical_bias Vertical bias (share of the vertical edges, normalized by the sum of the biases)
+ * @param cycle_bias Cycle bias
+ * @param gen Random number generator
+ */
+void carve_kruskal(const std::shared_ptr<Graph> &maze, float horizontal_bias, float vertical_bias, float cycle_bias,
+                   Philox &gen) {
     int to_add = (int) (cycle_bias * (float) (maze->get_v() - maze->get_width() - maze->get_height() + 1));
-    int total_walls = maze->get_v() - maze->get_width() - maze->get_height() - to_add + 1;
-    int horizontal_walls = (int) (vertical_bias * (float) total_walls);
-    int vertical_walls = total_walls - horizontal_walls;
-    int horizontal_edges = maze->get_v() - maze->get_width() - horizontal_walls;
-    int vertical_edges = maze->get_v() - maze->get_height() - vertical_walls;
     int counter_horizontal = 0;
     int counter_vertical = 0;
-    std::shared_ptr<Graph> available_edges = maze->create_copy();
-    std::shared_ptr<Graph> maze_copy = maze->create_copy();
     Disjoint_union_sets disjoint_union_sets(maze->get_v());
-
-    std::default_random_engine gen(std::chrono::system_clock::now().time_since_epoch().count());
     std::uniform_int_distribution<int> dis(0, RAND_MAX);
 
+    // One flat list of the base graph edges (node, slot) split into horizontal and vertical buckets,
+    // then close every edge of the maze
+    auto &topology = maze->get_topology();
+    std::vector<std::pair<int, int>> horizontal;
+    std::vector<std::pair<int, int>> vertical;
     for (int i = 0; i < maze->get_v(); i++) {
-        std::shuffle(maze_copy->get_adj()[i].begin(), maze_copy->get_adj()[i].end(), gen);
-        for (int j: maze->get_adj()[i]) {
-            maze->remove_edge(i, j);
+        for (unsigned mask = maze->get_open_mask(i); mask; mask &= mask - 1) {
+            auto slot = std::countr_zero(mask);
+            auto j = topology->get_neighbor(i, slot);
+            if (i < j) // Every edge only once
+                (is_horizontal(maze->get_x(i), maze->get_y(i), maze->get_x(j), maze->get_y(j)) ? horizontal : vertical)
+                        .emplace_back(i, slot);
         }
+        maze->clear_edges(i);
     }
+    std::shuffle(horizontal.begin(), horizontal.end(), gen);
+    std::shuffle(vertical.begin(), vertical.end(), gen);
+
+    // Quotas of the buckets, the edges of a spanning tree plus the cycles are split by the biases (normalized),
+    // a quota larger than its bucket passes the rest to the other bucket
+    auto bias_sum = horizontal_bias + vertical_bias;
+    auto horizontal_share = bias_sum > 0 ? horizontal_bias / bias_sum : 0.5f;
+    int total_edges = maze->get_v() - 1 + to_add;
+    int horizontal_edges = std::min((int) std::lround(horizontal_share * (float) total_edges), (int) horizontal.size());
+    int vertical_edges = std::min(total_edges - horizontal_edges, (int) vertical.size());
+    horizontal_edges = std::min(total_edges - vertical_edges, (int) horizontal.size());
 
-    std::vector<int> random_indices = std::vector<int>(maze->get_v());
-    std::iota(random_indices.begin(), random_indices.end(), 0);
-    std::shuffle(random_indices.begin(), random_indices.end(), gen);
+    // Opens an edge and counts it in the bucket of its direction (the slot alone does not tell it on every lattice)
+    auto add_edge = [&](int i, int slot) {
+        auto j = topology->get_neighbor(i, slot);
+        maze->open_slot(i, slot);
+        (is_horizontal(maze->get_x(i), maze->get_y(i), maze->get_x(j), maze->get_y(j)) ? counter_horizontal
+                                                                                      : counter_vertical)++;
+    };
 
-    // First add necessary edges to make sure that the maze is connected (vertically)
+    // First add necessary edges to make sure that the maze is connected (vertically), one per pair of rows
     for (int i = 0; i < maze->get_height() - 1; i++) {
-        bool break_flag = false;
-        for (int j: random_indices) {
-            for (int k: random_indices) {
-                if (j % maze->get_height() == i && k % maze->get_height() == i + 1 &&
-                    available_edges->is_adjacent(j, k)) {
-                    maze->add_edge(j, k);
-                    available_edges->remove_edge(j, k);
-                    disjoint_union_sets.merge(j, k);
-                    counter_vertical++;
-                    break_flag = true;
-                    break;
-                }
-            }
-            if (break_flag)
-                break;
-        }
+        auto node = (dis(gen) % maze->get_width()) * maze->get_height() + i;
+        if (disjoint_union_sets.merge(node, topology->get_neighbor(node, 3)))
+            add_edge(node, 3);
     }
 
-    // Then add necessary edges to make sure that the maze is connected (horizontally)
+    // Then add necessary edges to make sure that the maze is connected (horizontally), one per pair of columns
     for (int i = 0; i < maze->get_width() - 1; i++) {
-        bool break_flag = false;
-        for (int j: random_indices) {
-            for (int k: random_indices) {
-                if (j / maze->get_height() == i && k / maze->get_height() == i + 1 &&
-                    available_edges->is_adjacent(j, k)) {
-                    maze->add_edge(j, k);
-                    available_edges->remove_edge(j, k);
-                    disjoint_union_sets.merge(j, k);
-                    counter_horizontal++;
-                    break_flag = true;
-                    break;
-                }
+        auto node = i * maze->get_height() + dis(gen) % maze->get_height();
+        if (disjoint_union_sets.merge(node, topology->get_neighbor(node, 1)))
+            add_edge(node, 1);
+    }
+
+    // Basic Kruskal's algorithm, the next edge comes from the bucket with more of its quota left (proportionally)
+    std::vector<std::pair<int, int>> spare_horizontal; // Edges closing a cycle (candidates for the cycle bias)
+    std::vector<std::pair<int, int>> spare_vertical;
+    size_t next_horizontal = 0;
+    size_t next_vertical = 0;
+    while (true) {
+        auto left_horizontal = next_horizontal < horizontal.size() ? std::max(horizontal_edges - counter_horizontal, 0) : 0;
+        auto left_vertical = next_vertical < vertical.size() ? std::max(vertical_edges - counter_vertical, 0) : 0;
+        if (left_horizontal + left_vertical == 0)
+            break;
+
+        auto take_horizontal = dis(gen) % (left_horizontal + left_vertical) < left_horizontal;
+        auto [i, slot] = take_horizontal ? horizontal[next_horizontal++] : vertical[next_vertical++];
+        if (disjoint_union_sets.merge(i, topology->get_neighbor(i, slot))) {
+            maze->open_slot(i, slot);
+            (take_horizontal ? counter_horizontal : counter_vertical)++;
+        } else {
+            (take_horizontal ? spare_horizontal : spare_vertical).emplace_back(i, slot);
+        }
+    }
+
+    // Connect what the quotas left apart (a bucket can run out of its quota before the maze is connected)
+    for (auto [bucket, next]: {std::pair{&horizontal, next_horizontal}, std::pair{&vertical, next_vertical}})
+        for (auto k = next; k < bucket->size(); k++) {
+            auto [i, slot] = (*bucket)[k];
+            if (disjoint_union_sets.merge(i, topology->get_neighbor(i, slot)))
+                add_edge(i, slot);
+        }
+
+    // Add the remaining edges to make sure that the cycle bias is respected, at most to_add of them in total
+    // (every edge opened so far is a tree edge, so the quotas alone could add cycles to a perfect maze)
+    auto cycles_left = total_edges - counter_horizontal - counter_vertical;
+    for (auto [i, slot]: spare_horizontal) {
+        if (cycles_left <= 0 || counter_horizontal >= horizontal_edges)
+            break;
+        if (maze->is_open(i, slot)) // Skip the connecting edges added at the start
+            continue;
+        add_edge(i, slot);
+        cycles_left--;
+    }
+    for (auto [i, slot]: spare_vertical) {
+        if (cycles_left <= 0 || counter_vertical >= vertical_edges)
+            break;
+        if (maze->is_open(i, slot))
+            continue;
+        add_edge(i, slot);
+        cycles_left--;
+    }
+}
+
+std::shared_ptr<Graph>
+Generator::generate_maze_kruskal(std::shared_ptr<Graph> &maze, float horizontal_bias, float vertical_bias,
+                                 float cycle_bias, uint64_t seed) {
+    Philox gen(seed, RandomStream::GENERATOR);
+    carve_kruskal(maze, horizontal_bias, vertical_bias, cycle_bias, gen);
+    return maze;
+}
+
+/**
+ * Creates the lattice graph of a tile of a maze, its open edges are the open edges of the maze inside the tile
+ * (the tile has to start on an even column, so hexagonal columns keep their parity)
+ * @tparam TYPE Lattice type
+ * @param maze Maze
+ * @param x0 First column of the tile
+ * @param y0 First row of the tile
+ * @param tile_width Width of the tile
+ * @param tile_height Height of the tile
+ * @return Graph of the tile
+ */
+template<GraphType TYPE>
+std::shared_ptr<Graph> create_tile_graph(const Graph &maze, int x0, int y0, int tile_width, int tile_height) {
+    CowArray<uint8_t> open(tile_width * tile_height, 0);
+    for (int i = 0; i < tile_width; i++)
+        for (int j = 0; j < tile_height; j++)
+            open.at_mut(i * tile_height + j) = maze.get_open_mask((x0 + i) * maze.get_height() + y0 + j) &
+                                               Lattice<TYPE>::slot_mask(i, j, tile_width, tile_height);
+
+    return std::make_shared<Graph>(std::make_shared<Topology>(tile_width, tile_height, TYPE, GRID_SIZE), std::move(open),
+                                   CowArray<uint64_t>((tile_width * tile_height + 63) / 64, ~0ull));
+}
+
+std::shared_ptr<Graph>
+Generator::generate_maze_parallel(std::shared_ptr<Graph> &maze, GeneratorType algorithm, float horizontal_bias,
+                                  float vertical_bias, float cycle_bias, int tile_size, unsigned threads,
+                                  uint64_t seed) {
+    auto &topology = maze->get_topology();
+    if (!topology->is_implicit()) // Tiles need a lattice
+        return algorithm == GeneratorType::KRUSKAL
+               ? generate_maze_kruskal(maze, horizontal_bias, vertical_bias, cycle_bias, seed)
+               : generate_maze_dfs(maze, seed);
+
+    auto create_tile = create_tile_graph<GraphType::ORTHOGONAL>;
+    if (topology->get_type() == GraphType::HEXAGONAL)
+        create_tile = create_tile_graph<GraphType::HEXAGONAL>;
+    else if (topology->get_type() == GraphType::LAPLACIAN)
+        create_tile = create_tile_graph<GraphType::LAPLACIAN>;
+
+    tile_size = std::max(tile_size + tile_size % 2, 2); // Even, so tiles start on even columns
+    auto width = maze->get_width();
+    auto height = maze->get_height();
+    auto tiles_x = (width + tile_size - 1) / tile_size;
+    auto tiles_y = (height + tile_size - 1) / tile_size;
+    auto tile_of = [&](int v) { return (v / height / tile_size) * tiles_y + v % height / tile_size; };
+
+    // Every tile gets its own substream, so the tiles do not depend on the scheduling nor on the number of threads
+    Philox gen(seed, RandomStream::GENERATOR);
+
+    // Edges that can be carved (snapshot of the base graph), closing all edges also unshares every page of the maze
+    auto base = maze->create_copy();
+    maze->close_all_edges();
+
+    // Spanning tree of every tile on the workers, tiles write disjoint runs of nodes (one per column of the tile)
+    ThreadPool pool(threads);
+    pool.parallel_for(tiles_x * tiles_y, [&](int64_t tile) {
+        auto x0 = static_cast<int>(tile / tiles_y) * tile_size;
+        auto y0 = static_cast<int>(tile % tiles_y) * tile_size;
+        auto tile_width = std::min(tile_size, width - x0);
+        auto tile_height = std::min(tile_size, height - y0);
+        auto tile_maze = create_tile(*base, x0, y0, tile_width, tile_height);
+        auto tile_gen = gen.substream(tile);
+        if (algorithm == GeneratorType::KRUSKAL)
+            carve_kruskal(tile_maze, horizontal_bias, vertical_bias, cycle_bias, tile_gen);
+        else
+            carve_dfs(tile_maze, tile_gen);
+
+        std::vector<uint8_t> column(tile_height);
+        for (int i = 0; i < tile_width; i++) {
+            for (int j = 0; j < tile_height; j++)
+                column[j] = tile_maze->get_open_mask(i * tile_height + j);
+            maze->write_open_masks((x0 + i) * height + y0, column.data(), tile_height);
+        }
+    });
+    maze->touch();
+
+    // Edges of the base graph between different tiles, only the cells on the borders of the tiles can have them
+    std::vector<std::pair<int, int>> seams;
+    for (int i = 0; i < width; i++) {
+        auto border_column = i % tile_size == 0 || i % tile_size == tile_size - 1;
+        for (int j = 0; j < height; j += border_column || j % tile_size == tile_size - 1 ? 1 : tile_size - 1) {
+            auto v = i * height + j;
+            for (unsigned mask = base->get_open_mask(v); mask; mask &= mask - 1) {
+                auto slot = std::countr_zero(mask);
+                auto neighbor = topology->get_neighbor(v, slot);
+                if (v < neighbor && tile_of(v) != tile_of(neighbor))
+                    seams.emplace_back(v, slot);
             }
-            if (break_flag)
-                break;
+        }
+    }
+    std::shuffle(seams.begin(), seams.end(), gen);
+
+    // Random spanning tree of the tiles (Kruskal), every tree edge is one opening on a seam
+    Disjoint_union_sets disjoint_union_sets(tiles_x * tiles_y);
+    std::vector<std::pair<int, int>> spare;
+    for (auto [v, slot]: seams) {
+        auto first = tile_of(v);
+        auto second = tile_of(topology->get_neighbor(v, slot));
+        if (disjoint_union_sets.merge(first, second)) {
+            maze->open_slot(v, slot);
+        } else {
+            spare.emplace_back(v, slot);
         }
     }
 
-    // Basic Kruskal's algorithm with counting of horizontal and vertical edges
-    for (int i: random_indices) {
-        for (int j: maze_copy->get_adj()[i]) {
-            if (disjoint_union_sets.find(i) != disjoint_union_sets.find(j)) {
-                if (is_horizontal(maze->get_nodes()[i]->get_x(), maze->get_nodes()[i]->get_y(),
-                                  maze->get_nodes()[j]->get_x(), maze->get_nodes()[j]->get_y())) {
-                    if (counter_horizontal < horizontal_edges) {
-                        maze->add_edge(i, j);
-                        available_edges->remove_edge(i, j);
-                        disjoint_union_sets.merge(i, j);
-                        counter_horizontal++;
-                    }
+    // Kruskal's cycle bias opens the same share of the remaining seam edges as of the remaining edges inside tiles
+    if (algorithm == GeneratorType::KRUSKAL)
+        for (size_t k = 0; k < static_cast<size_t>(cycle_bias * static_cast<float>(spare.size())); k++)
+            maze->open_slot(spare[k].first, spare[k].second);
+
+    return maze;
+}
+
+void Generator::generate_maze_tiled(ChunkedMaze &maze, uint64_t seed) {
+    Philox gen(seed, RandomStream::GENERATOR);
+    std::uniform_int_distribution<int64_t> dis(0, INT64_MAX);
+
+    auto degree = Lattice<GraphType::ORTHOGONAL>::DEGREE;
+    if (maze.get_type() == GraphType::HEXAGONAL)
+        degree = Lattice<GraphType::HEXAGONAL>::DEGREE;
+    else if (maze.get_type() == GraphType::LAPLACIAN)
+        degree = Lattice<GraphType::LAPLACIAN>::DEGREE;
+
+    auto height = maze.get_height();
+    auto tiles_x = (maze.get_width() + CHUNK_TILE_SIZE - 1) / CHUNK_TILE_SIZE;
+    auto tiles_y = (height + CHUNK_TILE_SIZE - 1) / CHUNK_TILE_SIZE;
+
+    // DFS inside every tile (cells are addressed locally, the stack and visited flags are reused)
+    std::vector<int> stack;
+    std::vector<bool> visited;
+    for (int64_t ti = 0; ti < tiles_x; ti++) {
+        for (int64_t tj = 0; tj < tiles_y; tj++) {
+            auto x0 = ti * CHUNK_TILE_SIZE;
+            auto y0 = tj * CHUNK_TILE_SIZE;
+            auto tile_width = std::min(CHUNK_TILE_SIZE, maze.get_width() - x0);
+            auto tile_height = std::min(CHUNK_TILE_SIZE, height - y0);
+            auto tile_gen = gen.substream(ti * tiles_y + tj);
+            visited.assign(tile_width * tile_height, false);
+            stack.push_back(0);
+            visited[0] = true;
+
+            while (!stack.empty()) {
+                auto local = stack.back();
+                auto cell = (x0 + local / tile_height) * height + y0 + local % tile_height;
+
+                // Unvisited neighbors inside the tile
+                int slots[MAX_DEGREE];
+                int neighbors[MAX_DEGREE];
+                auto count = 0;
+                for (int slot = 0; slot < degree; slot++) {
+                    auto neighbor = maze.get_neighbor(cell, slot);
+                    if (neighbor == -1)
+                        continue;
+                    auto ni = neighbor / height - x0;
+                    auto nj = neighbor % height - y0;
+                    if (ni < 0 || ni >= tile_width || nj < 0 || nj >= tile_height || visited[ni * tile_height + nj])
+                        continue;
+                    slots[count] = slot;
+                    neighbors[count++] = static_cast<int>(ni * tile_height + nj);
+                }
+
+                if (count == 0) {
+                    stack.pop_back();
                 } else {
-                    if (counter_vertical < vertical_edges) {
-                        maze->add_edge(i, j);
-                        available_edges->remove_edge(i, j);
-                        disjoint_union_sets.merge(i, j);
-                        counter_vertical++;
-                    }
+                    auto chosen = static_cast<int>(dis(tile_gen) % count);
+                    maze.open_slot(cell, slots[chosen]);
+                    visited[neighbors[chosen]] = true;
+                    stack.push_back(neighbors[chosen]);
                 }
             }
         }
     }
 
-    // Add the remaining edges to make sure that the cycle bias is respected
-    while (counter_horizontal + counter_vertical < horizontal_edges + vertical_edges) {
-        for (int i: random_indices) {
-            for (int j: random_indices) {
-                if (available_edges->is_adjacent(i, j)) {
-                    if (is_horizontal(maze->get_nodes()[i]->get_x(), maze->get_nodes()[i]->get_y(),
-                                      maze->get_nodes()[j]->get_x(), maze->get_nodes()[j]->get_y())) {
-                        if (counter_horizontal < horizontal_edges) {
-                            maze->add_edge(i, j);
-                            available_edges->remove_edge(i, j);
-                            disjoint_union_sets.merge(i, j);
-                            counter_horizontal++;
-                        }
-                    } else {
-                        if (counter_vertical < vertical_edges) {
-                            maze->add_edge(i, j);
-                            available_edges->remove_edge(i, j);
-                            disjoint_union_sets.merge(i, j);
-                            counter_vertical++;
-                        }
-                    }
-                }
-            }
+    // Random spanning tree of the tiles (Kruskal), every tree edge opens one random cell on the seam
+    std::vector<std::pair<int64_t, bool>> seams; // Tile index, true for the seam to the right, false for the one below
+    for (int64_t ti = 0; ti < tiles_x; ti++) {
+        for (int64_t tj = 0; tj < tiles_y; tj++) {
+            if (ti + 1 < tiles_x)
+                seams.emplace_back(ti * tiles_y + tj, true);
+            if (tj + 1 < tiles_y)
+                seams.emplace_back(ti * tiles_y + tj, false);
         }
     }
+    std::shuffle(seams.begin(), seams.end(), gen);
 
+    Disjoint_union_sets disjoint_union_sets(static_cast<int>(tiles_x * tiles_y));
+    for (auto &[tile, right]: seams) {
+        auto other = right ? tile + tiles_y : tile + 1;
+        if (!disjoint_union_sets.merge(static_cast<int>(tile), static_cast<int>(other)))
+            continue;
+
+        auto x0 = (tile / tiles_y) * CHUNK_TILE_SIZE;
+        auto y0 = (tile % tiles_y) * CHUNK_TILE_SIZE;
+        if (right) { // Last column of the tile, random row, slot 1 (right)
+            auto y = y0 + dis(gen) % std::min(CHUNK_TILE_SIZE, height - y0);
+            maze.open_slot((x0 + CHUNK_TILE_SIZE - 1) * height + y, 1);
+        } else { // Last row of the tile, random column, slot 3 (down)
+            auto x = x0 + dis(gen) % std::min(CHUNK_TILE_SIZE, maze.get_width() - x0);
+            maze.open_slot(x * height + y0 + CHUNK_TILE_SIZE - 1, 3);
+        }
+    }
+}
+
+void Generator::generate_maze_eller(int width, int64_t height, float horizontal_bias, float vertical_bias,
+                                    uint64_t seed,
+                                    const std::function<void(int64_t, const std::vector<uint8_t> &)> &sink) {
+    EllerGenerator eller(width, horizontal_bias, vertical_bias, seed);
+    for (int64_t j = 0; j < height; j++)
+        sink(j, eller.next_row(j == height - 1));
+}
+
+std::shared_ptr<Graph>
+Generator::generate_maze_eller(std::shared_ptr<Graph> &maze, float horizontal_bias, float vertical_bias,
+                               uint64_t seed) {
+    maze->close_all_edges();
+    auto height = maze->get_height();
+    generate_maze_eller(maze->get_width(), height, horizontal_bias, vertical_bias, seed,
+                        [&](int64_t j, const std::vector<uint8_t> &masks) {
+                            // Right and down passages open both directions
+                            auto width = static_cast<int>(masks.size());
+                            for (int i = 0; i < width; i++) {
+                                if (masks[i] & (1 << 1))
+                                    maze->open_slot(i * height + static_cast<int>(j), 1);
+                                if (masks[i] & (1 << 3))
+                                    maze->open_slot(i * height + static_cast<int>(j), 3);
+                            }
+                        });
     return maze;
 }
+
+bool Generator::generate_maze_eller_pgm(const std::string &filename, int width, int64_t height, float horizontal_bias,
+                                        float vertical_bias, uint64_t seed) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file)
+        return false;
+
+    // Binary grayscale image, walls are black, paths are white
+    auto image_width = 2 * width + 1;
+    file << "P5\n" << image_width << " " << 2 * height + 1 << "\n255\n";
+    std::vector<char> cells(image_width, 0);
+    std::vector<char> walls(image_width, 0);
+    file.write(walls.data(), image_width); // Top border
+
+    auto write_row = [&](int64_t, const std::vector<uint8_t> &masks) {
+        // Row of cells with the walls between them, then the row of walls below them
+        for (int i = 0; i < width; i++) {
+            cells[2 * i + 1] = static_cast<char>(255);
+            cells[2 * i + 2] = static_cast<char>(masks[i] & (1 << 1) ? 255 : 0);
+            walls[2 * i + 1] = static_cast<char>(masks[i] & (1 << 3) ? 255 : 0);
+        }
+        cells[image_width - 1] = 0;
+        file.write(cells.data(), image_width);
+        file.write(walls.data(), image_width);
+    };
+    generate_maze_eller(width, height, horizontal_bias, vertical_bias, seed, write_row);
+
+    return file.good();
+}
@@ -6,7 +6,13 @@
 #include <chrono>
 #include <algorithm>
 #include <numeric>
+#include <string>
+#include <functional>
 #include "graph.h"
+#include "chunked_maze.h"
+#include "eller_generator.h"
+#include "thread_pool.h"
+#include "philox.h"
 #include "disjoint_union_sets.h"
 
 /**
@@ -19,32 +25,39 @@ public:
      * @param width Width of the grid
      * @param height Height of the grid
      * @param non_grid Non-grid flag (default: false)
+     * @param seed Seed of the noise of the non-grid version (default: 0)
+     * @param threads Number of threads for big grids (default: 1, on the calling thread; 0 for the number of hardware threads)
      * @return Orthogonal grid graph
      */
-    static std::shared_ptr<Graph> create_orthogonal_grid_graph(int width, int height, bool non_grid = false);
+    static std::shared_ptr<Graph> create_orthogonal_grid_graph(int width, int height, bool non_grid = false, uint64_t seed = 0, unsigned threads = 1);
     /**
      * Create a graph with a grid hexagonal structure
      * @param width Width of the grid
      * @param height Height of the grid
      * @param non_grid Non-grid flag (default: false)
+     * @param seed Seed of the noise of the non-grid version (default: 0)
+     * @param threads Number of threads for big grids (default: 1, on the calling thread; 0 for the number of hardware threads)
      * @return Hexagonal grid graph
      */
-    static std::shared_ptr<Graph> create_hexagonal_grid_graph(int width, int height, bool non_grid = false);
+    static std::shared_ptr<Graph> create_hexagonal_grid_graph(int width, int height, bool non_grid = false, uint64_t seed = 0, unsigned threads = 1);
     /**
      * Create a graph with a grid orthogonal structure with diagonals
      * @param width Width of the grid
      * @param height Height of the grid
      * @param non_grid Non-grid flag (default: false)
+     * @param seed Seed of the noise of the non-grid version (default: 0)
+     * @param threads Number of threads for big grids (default: 1, on the calling thread; 0 for the number of hardware threads)
      * @return Orthogonal grid graph with diagonals
      */
-    static std::shared_ptr<Graph> create_orthogonal_grid_graph_laplacian(int width, int height, bool non_grid = false);
+    static std::shared_ptr<Graph> create_orthogonal_grid_graph_laplacian(int width, int height, bool non_grid = false, uint64_t seed = 0, unsigned threads = 1);
 
     /**
      * Generate a maze using the depth-first search algorithm
      * @param maze Base graph
+     * @param seed Seed (default: 0)
      * @return Maze graph
      */
-    static std::shared_ptr<Graph> generate_maze_dfs(std::shared_ptr<Graph> &maze);
+    static std::shared_ptr<Graph> generate_maze_dfs(std::shared_ptr<Graph> &maze, uint64_t seed = 0);
 
     /**
      * Generate a maze using the Modified Kruskal's algorithm
@@ -52,7 +65,71 @@ public:
      * @param horizontal_bias Horizontal bias
      * @param vertical_bias Vertical bias
      * @param cycle_bias Cycle bias
+     * @param seed Seed (default: 0)
      * @return Maze graph
      */
-    static std::shared_ptr<Graph> generate_maze_kruskal(std::shared_ptr<Graph> &maze, float horizontal_bias = 0.5f, float vertical_bias = 0.5f, float cycle_bias = 0.0f);
+    static std::shared_ptr<Graph> generate_maze_kruskal(std::shared_ptr<Graph> &maze, float horizontal_bias = 0.5f, float vertical_bias = 0.5f, float cycle_bias = 0.0f, uint64_t seed = 0);
+    /**
+     * Generates a perfect maze in an out-of-core maze (all walls at the start)
+     * Every tile is carved with DFS on its own, then the tiles are joined by a random spanning tree
+     * with one opening per seam, so only one tile has to be in memory at a time
+     * @param maze Maze to be generated
+     * @param seed Seed, every tile uses its own substream
+     */
+    static void generate_maze_tiled(ChunkedMaze &maze, uint64_t seed = 0);
+    /**
+     * Generates a maze on several threads, the lattice is split into square tiles, every tile gets its own
+     * spanning tree (DFS or Kruskal's Modified Algorithm) and the tiles are stitched by a random spanning tree
+     * of openings on the seams between them
+     * (graphs without a lattice topology are generated on one thread)
+     * @param maze Maze to be generated
+     * @param algorithm Generator algorithm of the tiles (Depth First Search or Kruskal's Modified Algorithm)
+     * @param horizontal_bias Horizontal bias (Kruskal's Modified Algorithm only)
+     * @param vertical_bias Vertical bias (Kruskal's Modified Algorithm only)
+     * @param cycle_bias Cycle bias, also the share of the extra seam openings (Kruskal's Modified Algorithm only)
+     * @param tile_size Width and height of a tile (rounded up to an even number)
+     * @param threads Number of threads (0 for the number of hardware threads)
+     * @param seed Seed, every tile uses its own substream (the maze does not depend on the number of threads)
+     * @return Generated maze
+     */
+    static std::shared_ptr<Graph>
+    generate_maze_parallel(std::shared_ptr<Graph> &maze, GeneratorType algorithm, float horizontal_bias = 0.5f,
+                           float vertical_bias = 0.5f, float cycle_bias = 0.0f, int tile_size = 256,
+                           unsigned threads = 0, uint64_t seed = 0);
+    /**
+     * Generates a maze with Eller's algorithm row by row, rows are passed to the sink as soon as they are final
+     * Memory is O(width) for any height
+     * @param width Width of the maze
+     * @param height Height of the maze
+     * @param horizontal_bias Probability of joining horizontally adjacent cells of different sets
+     * @param vertical_bias Probability of an extra downward passage
+     * @param seed Seed
+     * @param sink Function called with the index and the open slot masks (0 left, 1 right, 2 up, 3 down) of every row
+     */
+    static void generate_maze_eller(int width, int64_t height, float horizontal_bias, float vertical_bias, uint64_t seed,
+                                    const std::function<void(int64_t, const std::vector<uint8_t> &)> &sink);
+    /**
+     * Generates a maze with Eller's algorithm
+     * (meant for Orthogonal Grid Graphs, other lattices only get their orthogonal edges)
+     * @param maze Maze to be generated
+     * @param horizontal_bias Probability of joining horizontally adjacent cells of different sets
+     * @param vertical_bias Probability of an extra downward passage
+     * @param seed Seed (default: 0)
+     * @return Generated maze
+     */
+    static std::shared_ptr<Graph> generate_maze_eller(std::shared_ptr<Graph> &maze, float horizontal_bias,
+                                                      float vertical_bias, uint64_t seed = 0);
+    /**
+     * Generates a maze with Eller's algorithm straight into a PGM image (one pixel per cell and per wall),
+     * image rows are written as soon as the maze rows are final
+     * @param filename Name of the image file
+     * @param width Width of the maze
+     * @param height Height of the maze
+     * @param horizontal_bias Probability of joining horizontally adjacent cells of different sets
+     * @param vertical_bias Probability of an extra downward passage
+     * @param seed Seed (default: 0)
+     * @return True if the image was written, false otherwise
+     */
+    static bool generate_maze_eller_pgm(const std::string &filename, int width, int64_t height, float horizontal_bias,
+                                        float vertical_bias, uint64_t seed = 0);
 };
@@ -1,8 +1,17 @@
 #include "graph.h"
 
-Graph::Graph(int width, int height) : width{width}, height{height}, v{width * height} {
-    adj.resize(v);
-    nodes.resize(v);
+Graph::Graph(std::shared_ptr<const Topology> topology, bool all_open)
+        : width{topology->get_width()}, height{topology->get_height()}, v{topology->get_v()},
+          topology{std::move(topology)}, open(v, 0), alive((v + 63) / 64, ~0ull), version{0} {
+    if (all_open)
+        for (int i = 0; i < v; i++)
+            open.at_mut(i) = this->topology->get_slot_mask(i);
+}
+
+Graph::Graph(std::shared_ptr<const Topology> topology, CowArray<uint8_t> open, CowArray<uint64_t> alive)
+        : width{topology->get_width()}, height{topology->get_height()}, v{topology->get_v()},
+          topology{std::move(topology)}, open{std::move(open)}, alive{std::move(alive)}, version{0} {
+    // Nothing to do here :)
 }
 
 int Graph::get_width() const {
@@ -17,91 +26,166 @@ int Graph::get_v() const {
     return v;
 }
 
-std::vector<std::vector<int>> &Graph::get_adj() {
-    return adj;
+const std::shared_ptr<const Topology> &Graph::get_topology() const {
+    return topology;
+}
+
+uint64_t Graph::get_version() const {
+    return version;
+}
+
+uint8_t Graph::get_open_mask(int index) const {
+    return open[index];
 }
 
-std::vector<std::shared_ptr<Node>> Graph::get_nodes() const {
-    return nodes;
+int Graph::get_x(int index) const {
+    return topology->get_x(index);
+}
+
+int Graph::get_y(int index) const {
+    return topology->get_y(index);
+}
+
+bool Graph::is_alive(int index) const {
+    return (alive[index / 64] >> (index % 64)) & 1;
+}
+
+void Graph::set_alive(int index, bool new_state) {
+    if (is_alive(index) == new_state)
+        return;
+
+    alive.at_mut(index / 64) ^= 1ull << (index % 64);
+    version++;
+}
+
+uint64_t Graph::get_alive_word(int word) const {
+    return alive[word];
+}
+
+void Graph::write_alive_words(int first, const uint64_t *words, int count) {
+    alive.write(first, words, count);
 }
 
 int Graph::get_nearest_node_to(const int x, const int y) const {
-    auto nearest = -1;
-    auto nearest_dx = WINDOW_WIDTH;
-    auto nearest_dy = WINDOW_WIDTH;
-
-    // Find the nearest node
-    for (auto &node: get_nodes()) {
-        auto dx = std::abs(node->get_x() - x);
-        auto dy = std::abs(node->get_y() - y);
-        // If the node is closer than the previous nearest node
-        if (dx * dx + dy * dy < nearest_dx * nearest_dx + nearest_dy * nearest_dy) {
-            nearest = node->get_v();
-            nearest_dx = dx;
-            nearest_dy = dy;
+    return topology->find_nearest(x, y, [](int) { return true; });
+}
+
+int Graph::get_nearest_alive_node_to(int x, int y) const {
+    // Alive flags are checked while searching, so changes of the alive nodes need no index updates
+    return topology->find_nearest(x, y, [this](int i) { return is_alive(i); });
+}
+
+bool Graph::add_edge(int src, int dest) {
+    auto slot = topology->find_slot(src, dest);
+    // The edge is not part of the topology yet -> rebuild the topology as an explicit one with the new edge (slow path)
+    if (slot == -1) {
+        if (std::popcount(topology->get_slot_mask(src)) == MAX_DEGREE ||
+            std::popcount(topology->get_slot_mask(dest)) == MAX_DEGREE)
+            return false;
+
+        auto edges = topology->get_edges();
+        std::vector<uint8_t> edges_open;
+        edges_open.reserve(edges.size() + 1);
+        for (auto &[a, b]: edges)
+            edges_open.push_back(is_adjacent(a, b));
+        edges.emplace_back(src, dest);
+        edges_open.push_back(1);
+
+        std::vector<int> xs(v);
+        std::vector<int> ys(v);
+        for (int i = 0; i < v; i++) {
+            xs[i] = topology->get_x(i);
+            ys[i] = topology->get_y(i);
         }
+        topology = std::make_shared<Topology>(width, height, edges, std::move(xs), std::move(ys));
+        open.fill(0);
+        for (size_t i = 0; i < edges.size(); i++)
+            if (edges_open[i])
+                add_edge(edges[i].first, edges[i].second);
+        return true;
     }
+    open_slot(src, slot);
+    return true;
+}
 
-    return nearest;
+void Graph::remove_edge(int src, int dest) {
+    auto slot = topology->find_slot(src, dest);
+    if (slot != -1)
+        close_slot(src, slot);
 }
 
-int Graph::get_nearest_alive_node_to(int x, int y) const {
-    std::vector<int> visited(v, 0);
-
-    while (true) { // true because there are always at least two alive nodes (start and end)
-        auto nearest = -1;
-        auto nearest_dx = WINDOW_WIDTH;
-        auto nearest_dy = WINDOW_WIDTH;
-
-        // Find the nearest node
-        for (auto &node: get_nodes()) {
-            auto dx = std::abs(node->get_x() - x);
-            auto dy = std::abs(node->get_y() - y);
-            // If the node is closer than the previous nearest node
-            if (dx * dx + dy * dy < nearest_dx * nearest_dx + nearest_dy * nearest_dy && !visited[node->get_v()]) {
-                nearest = node->get_v();
-                nearest_dx = dx;
-                nearest_dy = dy;
-            }
-        }
+bool Graph::is_adjacent(int src, int dest) const {
+    auto slot = topology->find_slot(src, dest);
+    return slot != -1 && is_open(src, slot);
+}
 
-        // If the nearest node is alive, return it
-        if (get_nodes()[nearest]->is_alive())
-            return nearest;
+bool Graph::is_open(int src, int slot) const {
+    return (open[src] >> slot) & 1;
+}
 
-        visited[nearest] = 1;
-    }
+void Graph::open_slot(int src, int slot) {
+    if (is_open(src, slot)) // Already open, do not touch the (possibly shared) page
+        return;
+
+    open.at_mut(src) |= 1 << slot;
+    open.at_mut(topology->get_neighbor(src, slot)) |= 1 << topology->get_reverse_slot(src, slot);
+    version++;
 }
 
-void Graph::set_node(int index, int x, int y) {
-    nodes[index] = std::make_shared<Node>(index, x, y);
+void Graph::close_slot(int src, int slot) {
+    if (!is_open(src, slot)) // Already closed, do not touch the (possibly shared) page
+        return;
+
+    open.at_mut(src) &= ~(1 << slot);
+    open.at_mut(topology->get_neighbor(src, slot)) &= ~(1 << topology->get_reverse_slot(src, slot));
+    version++;
 }
 
-void Graph::add_edge(int src, int dest) {
-    if (std::find(adj[src].begin(), adj[src].end(), dest) == adj[src].end())
-        adj[src].push_back(dest);
-    if (std::find(adj[dest].begin(), adj[dest].end(), src) == adj[dest].end())
-        adj[dest].push_back(src);
+void Graph::clear_edges(int src) {
+    for (unsigned mask = open[src]; mask; mask &= mask - 1)
+        close_slot(src, std::countr_zero(mask));
 }
 
-void Graph::remove_edge(int src, int dest) {
-    adj[src].erase(std::remove(adj[src].begin(), adj[src].end(), dest), adj[src].end());
-    adj[dest].erase(std::remove(adj[dest].begin(), adj[dest].end(), src), adj[dest].end());
+void Graph::close_all_edges() {
+    open.fill(0);
+    version++;
 }
 
-bool Graph::is_adjacent(int src, int dest) const {
-    return std::find(adj[src].begin(), adj[src].end(), dest) != adj[src].end();
+void Graph::read_open_masks(int first, uint8_t *masks, int count) const {
+    open.read(first, masks, count);
+}
+
+void Graph::write_open_masks(int first, const uint8_t *masks, int count) {
+    open.write(first, masks, count);
+}
+
+void Graph::touch() {
+    version++;
+}
+
+void Graph::apply_delta(const GenerationDelta &delta) {
+    for (auto i: delta.born)
+        set_alive(i, true);
+    for (auto i: delta.died)
+        set_alive(i, false);
+    for (auto &[src, dest]: delta.opened)
+        add_edge(src, dest);
+    for (auto &[src, dest]: delta.closed)
+        remove_edge(src, dest);
+}
+
+void Graph::copy_from(const Graph &other) {
+    open.copy_from(other.open);
+    alive.copy_from(other.alive);
+    version = other.version;
+}
+
+void Graph::make_unique() {
+    open.make_unique();
+    alive.make_unique();
 }
 
 std::shared_ptr<Graph> Graph::create_copy() const {
-    auto copy = std::make_shared<Graph>(width, height);
-    for (auto &node: nodes) {
-        copy->set_node(node->get_v(), node->get_x(), node->get_y());
-        if (!node->is_alive())
-            copy->get_nodes()[node->get_v()]->set_alive(false);
-    }
-    for (int i = 0; i < v; i++)
-        for (auto &j: adj[i])
-            copy->add_edge(i, j);
-    return copy;
+    // The topology is immutable and the node data is copy-on-write, so the copy shares everything
+    return std::make_shared<Graph>(*this);
 }
@@ -1,18 +1,23 @@
 #pragma once
 
 #include <iostream>
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <cmath>
 #include <algorithm>
+#include <bit>
 #include <random>
 #include <chrono>
-#include "GLFW/glfw3.h"
 #include "../const.h"
-#include "node.h"
+#include "topology.h"
+#include "cow_array.h"
+#include "generation_delta.h"
 
 /**
  * Graph class
+ * Edges of a node are stored as a bitmask of open slots of the (shared) topology
+ * Node data lives in copy-on-write pages, so copies of the graph are cheap snapshots
  */
 class Graph {
 private:
@@ -22,18 +27,30 @@ private:
     int height;
     /** Number of vertices */
     int v;
-    /** Adjacency list */
-    std::vector<std::vector<int>> adj;
-    /** Nodes */
-    std::vector<std::shared_ptr<Node>> nodes;
+    /** Fixed topology with positions of the nodes (shared between copies of the graph) */
+    std::shared_ptr<const Topology> topology;
+    /** Bitmask of open slots of every node (carved paths or edges between alive nodes) */
+    CowArray<uint8_t> open;
+    /** Alive flags of the nodes packed into 64-bit words (used for Cellular Automatas) */
+    CowArray<uint64_t> alive;
+    /** Version of the graph (incremented by every change) */
+    uint64_t version;
 
 public:
     /**
      * Constructor
-     * @param width Width of the graph
-     * @param height Height of the graph
+     * @param topology Fixed topology of the graph
+     * @param all_open True if all the topology edges should start open, false if they should start closed
      */
-    Graph(int width, int height);
+    explicit Graph(std::shared_ptr<const Topology> topology, bool all_open = true);
+
+    /**
+     * Constructor from existing node data (for example pages of a memory mapped file)
+     * @param topology Fixed topology of the graph
+     * @param open Bitmask of open slots of every node
+     * @param alive Alive flags of the nodes packed into 64-bit words
+     */
+    Graph(std::shared_ptr<const Topology> topology, CowArray<uint8_t> open, CowArray<uint64_t> alive);
 
     /**
      * Destructor
@@ -59,22 +76,85 @@ public:
     [[nodiscard]] int get_v() const;
 
     /**
-     * Getter for adjacency list
-     * @return Adjacency list
+     * Getter for topology
+     * @return Fixed topology of the graph
+     */
+    [[nodiscard]] const std::shared_ptr<const Topology> &get_topology() const;
+
+    /**
+     * Getter for version
+     * @return Version of the graph, copies start with the version of the original graph
+     */
+    [[nodiscard]] uint64_t get_version() const;
+
+    /**
+     * Getter for the open slots of a node
+     * @param index Index of the node (v)
+     * @return Bitmask, bit k is set if the edge in slot k is open
      */
-    [[nodiscard]] std::vector<std::vector<int>> &get_adj();
+    [[nodiscard]] uint8_t get_open_mask(int index) const;
 
     /**
-     * Getter for nodes
-     * @return Nodes list of references to nodes
+     * Calls the given function for every neighbor connected by an open edge
+     * @tparam F Function type (void(int))
+     * @param src Node index
+     * @param f Function to call with the node index of the neighbor
      */
-    [[nodiscard]] std::vector<std::shared_ptr<Node>> get_nodes() const;
+    template<typename F>
+    void for_each_neighbor(int src, F &&f) const {
+        for (unsigned mask = open[src]; mask; mask &= mask - 1)
+            f(topology->get_neighbor(src, std::countr_zero(mask)));
+    }
+
+    /**
+     * Getter for X coordinate of a node
+     * @param index Index of the node (v)
+     * @return X coordinate
+     */
+    [[nodiscard]] int get_x(int index) const;
+
+    /**
+     * Getter for Y coordinate of a node
+     * @param index Index of the node (v)
+     * @return Y coordinate
+     */
+    [[nodiscard]] int get_y(int index) const;
+
+    /**
+     * Getter for alive flag of a node
+     * @param index Index of the node (v)
+     * @return Alive flag
+     */
+    [[nodiscard]] bool is_alive(int index) const;
+
+    /**
+     * Setter for alive flag of a node
+     * @param index Index of the node (v)
+     * @param new_state New state of alive flag
+     */
+    void set_alive(int index, bool new_state);
+
+    /**
+     * Getter for the alive flags of 64 consecutive nodes
+     * @param word Index of the word (nodes 64 * word ... 64 * word + 63)
+     * @return Alive flags, bit k belongs to the node 64 * word + k (bits past the last node are undefined)
+     */
+    [[nodiscard]] uint64_t get_alive_word(int word) const;
+
+    /**
+     * Overwrites the alive flags of a run of consecutive words (64 nodes each)
+     * The version does not change (call touch after the bulk writes), the caller keeps the edges consistent
+     * @param first Index of the first word of the run
+     * @param words Alive flags of the words of the run
+     * @param count Number of words of the run
+     */
+    void write_alive_words(int first, const uint64_t *words, int count);
 
     /**
      * Finds the nearest node to the given coordinates
      * @param x X coordinate
      * @param y Y coordinate
-     * @return Vertex index of the nearest node
+     * @return Vertex index of the nearest node, -1 if the graph is empty
      */
     [[nodiscard]] int get_nearest_node_to(int x, int y) const;
 
@@ -82,24 +162,76 @@ public:
      * Finds the nearest alive node to the given coordinates
      * @param x X coordinate
      * @param y Y coordinate
-     * @return Vertex index of the nearest alive node
+     * @return Vertex index of the nearest alive node, -1 if no node is alive
      */
     [[nodiscard]] int get_nearest_alive_node_to(int x, int y) const;
 
     /**
-     * Sets the node at the given index to the given coordinates
-     * @param index Index of the node (v)
-     * @param x X coordinate
-     * @param y Y coordinate
+     * Checks if the edge in the given slot is open
+     * @param src Node index
+     * @param slot Slot of the edge
+     * @return True if the edge is open, false otherwise
+     */
+    [[nodiscard]] bool is_open(int src, int slot) const;
+
+    /**
+     * Opens the edge in the given slot (in both directions)
+     * @param src Node index
+     * @param slot Slot of the edge (must lead to a neighbor)
+     */
+    void open_slot(int src, int slot);
+
+    /**
+     * Closes the edge in the given slot (in both directions)
+     * @param src Node index
+     * @param slot Slot of the edge (must lead to a neighbor)
+     */
+    void close_slot(int src, int slot);
+
+    /**
+     * Closes all edges of a node
+     * @param src Node index
      */
-    void set_node(int index, int x, int y);
+    void clear_edges(int src);
+
+    /**
+     * Closes all edges of the graph
+     */
+    void close_all_edges();
+
+    /**
+     * Copies the open slot masks of a run of consecutive nodes
+     * @param first Node index of the first node of the run
+     * @param masks Open slot masks of the nodes of the run (output)
+     * @param count Number of nodes of the run
+     */
+    void read_open_masks(int first, uint8_t *masks, int count) const;
+
+    /**
+     * Overwrites the open slot masks of a run of consecutive nodes
+     * The masks are not mirrored to the neighbors and the version does not change (call touch after the bulk writes),
+     * the caller keeps both edge directions consistent; runs of different nodes can be written from different threads
+     * once no page is shared (e.g. right after close_all_edges)
+     * @param first Node index of the first node of the run
+     * @param masks Open slot masks of the nodes of the run
+     * @param count Number of nodes of the run
+     */
+    void write_open_masks(int first, const uint8_t *masks, int count);
+
+    /**
+     * Marks the graph as changed (increments the version once after a batch of bulk writes)
+     */
+    void touch();
 
     /**
      * Adds an edge to the graph
+     * Opens the edge if it is part of the topology, otherwise the topology is rebuilt as an explicit one
+     * (nodes that already have MAX_DEGREE neighbors can not get another one)
      * @param src Node index
      * @param dest Node index
+     * @return True if the edge is open, false if an endpoint already has MAX_DEGREE neighbors (nothing changes)
      */
-    void add_edge(int src, int dest);
+    bool add_edge(int src, int dest);
 
     /**
      * Removes an edge from the graph
@@ -117,8 +249,28 @@ public:
     [[nodiscard]] bool is_adjacent(int src, int dest) const;
 
     /**
-     * Creates a deep copy of the graph
-     * @return Deep copy of the graph
+     * Applies the changes of a generation to the graph (in O(size of the delta))
+     * @param delta Changes to apply
+     */
+    void apply_delta(const GenerationDelta &delta);
+
+    /**
+     * Overwrites the node data with the one of another graph with the same topology
+     * Pages of this graph that are not shared are reused (no allocation)
+     * @param other Graph to copy
+     */
+    void copy_from(const Graph &other);
+
+    /**
+     * Clones all the pages shared with other graphs, so later changes of this graph allocate nothing
+     */
+    void make_unique();
+
+    /**
+     * Creates a copy of the graph
+     * The copy shares the topology and all the pages of node data with the original graph,
+     * pages are cloned on the first change, so the copy costs O(V / page size) and every change O(page size) at most
+     * @return Copy of the graph
      */
     [[nodiscard]] std::shared_ptr<Graph> create_copy() const;
 };
@@ -0,0 +1,110 @@
+#include "infinite_maze.h"
+
+InfiniteMaze::InfiniteMaze(uint64_t seed, GeneratorType algorithm, float horizontal_bias, float vertical_bias,
+                           float loop_bias, size_t capacity)
+        : seed{seed}, algorithm{algorithm}, horizontal_bias{horizontal_bias}, vertical_bias{vertical_bias},
+          loop_bias{loop_bias}, capacity{std::max<size_t>(capacity, 1)}, last_key{0}, last{nullptr}, generated{0} {
+    // Nothing to do here :)
+}
+
+uint64_t InfiniteMaze::get_key(int64_t cx, int64_t cy) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32 | static_cast<uint32_t>(cy);
+}
+
+int InfiniteMaze::get_seam_opening(int64_t cx, int64_t cy, bool top) const {
+    // The chunk links to its left or top neighbor, both seams have their own opening and their own loop chance
+    auto gen = Philox(seed, RandomStream::SEAMS).substream(get_key(cx, cy));
+    auto link_top = (gen() & 1) == 1;
+    auto left = static_cast<int>(gen() % INFINITE_CHUNK_SIZE);
+    auto up = static_cast<int>(gen() % INFINITE_CHUNK_SIZE);
+    auto left_loop = static_cast<float>(gen()) / 4294967296.0f < loop_bias;
+    auto up_loop = static_cast<float>(gen()) / 4294967296.0f < loop_bias;
+
+    if (top)
+        return link_top || up_loop ? up : -1;
+    return !link_top || left_loop ? left : -1;
+}
+
+void InfiniteMaze::generate_chunk(int64_t cx, int64_t cy, std::vector<uint8_t> &cells) {
+    // Inside of the chunk from the Generator, seeded by the chunk coordinates
+    auto gen = Philox(seed, RandomStream::GENERATOR).substream(get_key(cx, cy));
+    uint64_t chunk_seed = static_cast<uint64_t>(gen()) << 32 | gen();
+    auto chunk = Generator::create_orthogonal_grid_graph(INFINITE_CHUNK_SIZE, INFINITE_CHUNK_SIZE);
+    if (algorithm == GeneratorType::KRUSKAL)
+        Generator::generate_maze_kruskal(chunk, horizontal_bias, vertical_bias, 0.0f, chunk_seed);
+    else if (algorithm == GeneratorType::ELLER)
+        Generator::generate_maze_eller(chunk, horizontal_bias, vertical_bias, chunk_seed);
+    else
+        Generator::generate_maze_dfs(chunk, chunk_seed);
+
+    cells.resize(INFINITE_CHUNK_SIZE * INFINITE_CHUNK_SIZE);
+    for (int v = 0; v < INFINITE_CHUNK_SIZE * INFINITE_CHUNK_SIZE; v++)
+        cells[v] = chunk->get_open_mask(v);
+
+    // Openings on the seams, the left and top ones belong to this chunk, the right and bottom ones to the neighbors
+    constexpr int LAST = INFINITE_CHUNK_SIZE - 1;
+    auto left = get_seam_opening(cx, cy, false);
+    if (left != -1)
+        cells[left] |= 1 << 0;
+    auto top = get_seam_opening(cx, cy, true);
+    if (top != -1)
+        cells[top * INFINITE_CHUNK_SIZE] |= 1 << 2;
+    auto right = get_seam_opening(cx + 1, cy, false);
+    if (right != -1)
+        cells[LAST * INFINITE_CHUNK_SIZE + right] |= 1 << 1;
+    auto bottom = get_seam_opening(cx, cy + 1, true);
+    if (bottom != -1)
+        cells[bottom * INFINITE_CHUNK_SIZE + LAST] |= 1 << 3;
+
+    generated++;
+}
+
+InfiniteMaze::Chunk &InfiniteMaze::get_chunk(int64_t cx, int64_t cy) {
+    auto key = get_key(cx, cy);
+    if (last && key == last_key)
+        return *last;
+
+    auto it = chunks.find(key);
+    if (it != chunks.end()) { // Cached -> move to the front of the LRU list
+        lru.splice(lru.begin(), lru, it->second.position);
+    } else {
+        // Evict the least recently used chunk, it is generated again if it is needed later
+        if (chunks.size() >= capacity) {
+            chunks.erase(lru.back());
+            lru.pop_back();
+        }
+
+        lru.push_front(key);
+        it = chunks.emplace(key, Chunk{{}, lru.begin()}).first;
+        generate_chunk(cx, cy, it->second.cells);
+    }
+
+    last_key = key;
+    last = &it->second;
+    return *last;
+}
+
+uint8_t InfiniteMaze::get_open_mask(int64_t x, int64_t y) {
+    // Floor division, so negative coordinates map to the chunks on the left and above
+    auto cx = x >= 0 ? x / INFINITE_CHUNK_SIZE : (x + 1) / INFINITE_CHUNK_SIZE - 1;
+    auto cy = y >= 0 ? y / INFINITE_CHUNK_SIZE : (y + 1) / INFINITE_CHUNK_SIZE - 1;
+    auto i = x - cx * INFINITE_CHUNK_SIZE;
+    auto j = y - cy * INFINITE_CHUNK_SIZE;
+    return get_chunk(cx, cy).cells[i * INFINITE_CHUNK_SIZE + j];
+}
+
+bool InfiniteMaze::is_open(int64_t x, int64_t y, int slot) {
+    return (get_open_mask(x, y) >> slot) & 1;
+}
+
+uint64_t InfiniteMaze::get_seed() const {
+    return seed;
+}
+
+size_t InfiniteMaze::get_cached_chunks() const {
+    return chunks.size();
+}
+
+uint64_t InfiniteMaze::get_generated_chunks() const {
+    return generated;
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <list>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "generator.h"
+#include "philox.h"
+
+/** Width and height of a chunk of an infinite maze in cells */
+constexpr int INFINITE_CHUNK_SIZE = 64;
+
+/**
+ * Unbounded maze on the orthogonal lattice, generated lazily chunk by chunk
+ * Every chunk is a function of (seed, chunk x, chunk y) only: its inside is generated by the Generator with
+ * a seed derived from the chunk coordinates, and the openings on its left and top seams are derived the same way,
+ * so neighboring chunks agree without coordination and evicted chunks regenerate identically
+ * Every chunk links to its left or its top neighbor through one opening (binary tree of the chunks,
+ * its random paths merge, so the maze is connected and stays perfect unless loop_bias opens extra seams)
+ * Cells have global coordinates (x to the right, y down), chunk coordinates must fit into 32 bits
+ */
+class InfiniteMaze {
+private:
+    /**
+     * Cached chunk
+     */
+    struct Chunk {
+        /** Open slot masks of the cells of the chunk (column-major, 0 left, 1 right, 2 up, 3 down) */
+        std::vector<uint8_t> cells;
+        /** Position of the chunk in the LRU list */
+        std::list<uint64_t>::iterator position;
+    };
+
+    /** Global seed */
+    uint64_t seed;
+    /** Generator algorithm of the chunks */
+    GeneratorType algorithm;
+    /** Horizontal bias (Kruskal's and Eller's algorithm) */
+    float horizontal_bias;
+    /** Vertical bias (Kruskal's and Eller's algorithm) */
+    float vertical_bias;
+    /** Probability of opening a seam that is not needed for the connectivity */
+    float loop_bias;
+    /** Maximal number of cached chunks */
+    size_t capacity;
+    /** Cached chunks by chunk key */
+    std::unordered_map<uint64_t, Chunk> chunks;
+    /** Chunk keys from the most to the least recently used */
+    std::list<uint64_t> lru;
+    /** Key of the last accessed chunk */
+    uint64_t last_key;
+    /** Last accessed chunk (nullptr if none, cached chunks do not move in memory) */
+    Chunk *last;
+    /** Number of generated chunks (including the regenerated ones) */
+    uint64_t generated;
+
+    /**
+     * Packs the chunk coordinates into one key
+     * @param cx Chunk x
+     * @param cy Chunk y
+     * @return Chunk key
+     */
+    static uint64_t get_key(int64_t cx, int64_t cy);
+
+    /**
+     * Computes the opening on the left or the top seam of a chunk
+     * @param cx Chunk x
+     * @param cy Chunk y
+     * @param top False for the left seam, true for the top seam
+     * @return Row (left seam) or column (top seam) of the opening inside the chunk, -1 if the seam is closed
+     */
+    [[nodiscard]] int get_seam_opening(int64_t cx, int64_t cy, bool top) const;
+
+    /**
+     * Generates a chunk
+     * @param cx Chunk x
+     * @param cy Chunk y
+     * @param cells Open slot masks of the cells of the chunk (output)
+     */
+    void generate_chunk(int64_t cx, int64_t cy, std::vector<uint8_t> &cells);
+
+    /**
+     * Gets the chunk, generates it if it is not cached (evicting the least recently used one)
+     * @param cx Chunk x
+     * @param cy Chunk y
+     * @return Chunk
+     */
+    Chunk &get_chunk(int64_t cx, int64_t cy);
+
+public:
+    /**
+     * Constructor
+     * @param seed Global seed
+     * @param algorithm Generator algorithm of the chunks
+     * @param horizontal_bias Horizontal bias (Kruskal's and Eller's algorithm)
+     * @param vertical_bias Vertical bias (Kruskal's and Eller's algorithm)
+     * @param loop_bias Probability of opening a seam that is not needed for the connectivity
+     * @param capacity Maximal number of chunks cached in memory (at least 1)
+     */
+    explicit InfiniteMaze(uint64_t seed, GeneratorType algorithm = GeneratorType::DEPTH_FIRST_SEARCH,
+                          float horizontal_bias = 0.5f, float vertical_bias = 0.5f, float loop_bias = 0.0f,
+                          size_t capacity = 256);
+
+    /**
+     * Getter for the open slots of a cell
+     * @param x Global x of the cell
+     * @param y Global y of the cell
+     * @return Bitmask, bit k is set if the edge in slot k is open (0 left, 1 right, 2 up, 3 down)
+     */
+    [[nodiscard]] uint8_t get_open_mask(int64_t x, int64_t y);
+
+    /**
+     * Checks if the edge in the given slot is open
+     * @param x Global x of the cell
+     * @param y Global y of the cell
+     * @param slot Slot (0 left, 1 right, 2 up, 3 down)
+     * @return True if the edge is open, false otherwise
+     */
+    [[nodiscard]] bool is_open(int64_t x, int64_t y, int slot);
+
+    /**
+     * Getter for seed
+     * @return Global seed
+     */
+    [[nodiscard]] uint64_t get_seed() const;
+
+    /**
+     * Getter for the number of cached chunks
+     * @return Number of chunks in memory
+     */
+    [[nodiscard]] size_t get_cached_chunks() const;
+
+    /**
+     * Getter for the number of generated chunks
+     * @return Number of generated chunks (including the regenerated ones)
+     */
+    [[nodiscard]] uint64_t get_generated_chunks() const;
+};
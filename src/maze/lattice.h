@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include "../const.h"
+
+/** Maximal number of neighbors of a node (every node keeps its edges in one byte) */
+constexpr int MAX_DEGREE = 8;
+
+/**
+ * Compile-time neighbor offsets of a lattice type
+ * Node in column i and row j has index v = i * height + j, slots are
+ * 0 left, 1 right, 2 up, 3 down (orthogonal)
+ * 4 left-up, 5 right-down, 6 left-down, 7 right-up (laplacian)
+ * 4 left diagonal, 5 right diagonal, up on even columns, down on odd columns (hexagonal)
+ * Opposite slots always differ in the lowest bit only
+ * @tparam TYPE Lattice type
+ */
+template<GraphType TYPE>
+struct Lattice {
+    /** Number of slots of the lattice */
+    static constexpr int DEGREE = TYPE == GraphType::ORTHOGONAL ? 4 : TYPE == GraphType::HEXAGONAL ? 6 : 8;
+    /** Column offsets of the slots */
+    static constexpr std::array<int, MAX_DEGREE> DI = {-1, 1, 0, 0, -1, 1, -1, 1};
+    /** Row offsets of the slots on even columns */
+    static constexpr std::array<int, MAX_DEGREE> DJ_EVEN = TYPE == GraphType::HEXAGONAL
+                                                           ? std::array<int, MAX_DEGREE>{0, 0, -1, 1, -1, -1, 0, 0}
+                                                           : std::array<int, MAX_DEGREE>{0, 0, -1, 1, -1, 1, 1, -1};
+    /** Row offsets of the slots on odd columns */
+    static constexpr std::array<int, MAX_DEGREE> DJ_ODD = TYPE == GraphType::HEXAGONAL
+                                                          ? std::array<int, MAX_DEGREE>{0, 0, -1, 1, 1, 1, 0, 0}
+                                                          : DJ_EVEN;
+
+    /**
+     * Computes the neighbor of a node
+     * @param i Column of the node
+     * @param j Row of the node
+     * @param width Width of the lattice
+     * @param height Height of the lattice
+     * @param slot Slot (less than DEGREE)
+     * @return Node index of the neighbor, -1 if the slot leads out of the lattice
+     */
+    static constexpr int neighbor(int i, int j, int width, int height, int slot) {
+        auto ni = i + DI[slot];
+        auto nj = j + (i % 2 == 0 ? DJ_EVEN[slot] : DJ_ODD[slot]);
+        if (ni < 0 || ni >= width || nj < 0 || nj >= height)
+            return -1;
+        return ni * height + nj;
+    }
+
+    /**
+     * Computes the mask of the slots of a node that lead to a neighbor
+     * @param i Column of the node
+     * @param j Row of the node
+     * @param width Width of the lattice
+     * @param height Height of the lattice
+     * @return Bitmask, bit k is set if slot k leads to a neighbor
+     */
+    static constexpr uint8_t slot_mask(int i, int j, int width, int height) {
+        uint8_t mask = 0;
+        for (int slot = 0; slot < DEGREE; slot++) // Fixed trip count, unrolled by the compiler
+            if (neighbor(i, j, width, height, slot) != -1)
+                mask |= 1 << slot;
+        return mask;
+    }
+
+    /**
+     * Calls the given function for the neighbor in every slot set in the mask
+     * @tparam F Function type (void(int))
+     * @param i Column of the node
+     * @param j Row of the node
+     * @param height Height of the lattice
+     * @param mask Slots to visit (must lead to neighbors, so the width is not needed)
+     * @param f Function to call with the node index of the neighbor
+     */
+    template<typename F>
+    static void for_each_neighbor(int i, int j, int height, unsigned mask, F &&f) {
+        auto &dj = i % 2 == 0 ? DJ_EVEN : DJ_ODD;
+        auto v = i * height + j;
+        for (; mask; mask &= mask - 1) {
+            auto slot = std::countr_zero(mask);
+            f(v + DI[slot] * height + dj[slot]);
+        }
+    }
+};
@@ -0,0 +1,228 @@
+#include "maze_file.h"
+#include <fstream>
+#include <cstring>
+
+#ifdef _WIN32
+#include <vector>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/** Version of the file format */
+constexpr uint32_t MAZE_FILE_VERSION = 1;
+/** Flag of the alive plane */
+constexpr uint32_t MAZE_FILE_ALIVE = 1;
+/** Flag of the position plane */
+constexpr uint32_t MAZE_FILE_POSITIONS = 2;
+
+/**
+ * Header of the maze file
+ */
+struct MazeFileHeader {
+    /** Magic bytes "MAZE" */
+    char magic[4];
+    /** Version of the file format */
+    uint32_t version;
+    /** Lattice type (GraphType) */
+    uint32_t type;
+    /** Flags of the optional planes */
+    uint32_t flags;
+    /** Width of the graph */
+    int32_t width;
+    /** Height of the graph */
+    int32_t height;
+    /** Distance of two neighboring nodes in pixels */
+    int32_t grid_size;
+    /** Reserved (zero) */
+    int32_t reserved;
+    /** Seed the graph was generated with (0 if unknown) */
+    uint64_t seed;
+    /** Offset of the edge plane */
+    uint64_t edges_offset;
+    /** Offset of the alive plane (0 if not present) */
+    uint64_t alive_offset;
+    /** Offset of the position plane (0 if not present) */
+    uint64_t positions_offset;
+};
+static_assert(sizeof(MazeFileHeader) == 64);
+
+/**
+ * Rounds the offset up to a multiple of 8
+ * @param offset Offset
+ * @return Aligned offset
+ */
+uint64_t align_offset(uint64_t offset) {
+    return (offset + 7) & ~uint64_t{7};
+}
+
+/**
+ * Checks if the plane lies inside the file
+ * @param offset Offset of the plane
+ * @param length Length of the plane in bytes
+ * @param size Size of the file
+ * @return True if the plane lies inside the file and is 8 byte aligned, false otherwise
+ */
+bool plane_fits(uint64_t offset, uint64_t length, uint64_t size) {
+    return offset % 8 == 0 && offset <= size && length <= size - offset;
+}
+
+/**
+ * Checks if the edge plane describes edges of the topology (every open slot has a neighbor that has the reverse slot open)
+ * Solvers and renderers index arrays with the neighbors of the open slots, so a corrupted plane must never get through
+ * @param masks Open slot masks of the nodes
+ * @param topology Topology of the graph
+ * @return True if the masks match the topology, false otherwise
+ */
+bool edges_match_topology(const uint8_t *masks, const Topology &topology) {
+    auto v = static_cast<int64_t>(topology.get_v());
+    for (int64_t i = 0; i < v; i++) {
+        if (masks[i] & ~topology.get_slot_mask(static_cast<int>(i)))
+            return false;
+        for (unsigned mask = masks[i]; mask; mask &= mask - 1) {
+            auto slot = std::countr_zero(mask);
+            auto neighbor = topology.get_neighbor(static_cast<int>(i), slot);
+            if (!((masks[neighbor] >> topology.get_reverse_slot(static_cast<int>(i), slot)) & 1))
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Maps the whole file into memory (read only)
+ * @param filename Name of the file
+ * @param size Size of the file (output)
+ * @return Owner of the mapped memory, nullptr if the file can not be mapped
+ */
+std::shared_ptr<const void> map_file(const std::string &filename, uint64_t &size) {
+#ifdef _WIN32
+    // No mmap, read the file into an 8 byte aligned buffer instead
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file)
+        return nullptr;
+    size = file.tellg();
+    auto buffer = std::make_shared<std::vector<uint64_t>>((size + 7) / 8);
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char *>(buffer->data()), static_cast<std::streamsize>(size)))
+        return nullptr;
+    return {buffer, buffer->data()};
+#else
+    auto fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+        return nullptr;
+    struct stat info{};
+    if (fstat(fd, &info) == -1 || info.st_size == 0) {
+        close(fd);
+        return nullptr;
+    }
+    size = info.st_size;
+    auto data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping stays valid without the descriptor
+    if (data == MAP_FAILED)
+        return nullptr;
+    return {data, [size](const void *p) { munmap(const_cast<void *>(p), size); }};
+#endif
+}
+
+bool MazeFile::save(const std::string &filename, const std::shared_ptr<Graph> &graph, uint64_t seed) {
+    auto &topology = graph->get_topology();
+    if (!topology->is_implicit())
+        return false;
+
+    auto v = static_cast<uint64_t>(graph->get_v());
+    auto all_alive = true;
+    for (uint64_t i = 0; i < v && all_alive; i++)
+        all_alive = graph->is_alive(i);
+
+    MazeFileHeader header{};
+    std::memcpy(header.magic, "MAZE", 4);
+    header.version = MAZE_FILE_VERSION;
+    header.type = static_cast<uint32_t>(topology->get_type());
+    header.width = graph->get_width();
+    header.height = graph->get_height();
+    header.grid_size = topology->get_grid_size();
+    header.seed = seed;
+    header.edges_offset = sizeof(MazeFileHeader);
+    auto end = header.edges_offset + v;
+    if (!all_alive) { // Alive plane is only needed if some node is dead
+        header.flags |= MAZE_FILE_ALIVE;
+        header.alive_offset = align_offset(end);
+        end = header.alive_offset + (v + 63) / 64 * sizeof(uint64_t);
+    }
+    if (topology->has_stored_positions()) {
+        header.flags |= MAZE_FILE_POSITIONS;
+        header.positions_offset = align_offset(end);
+        end = header.positions_offset + 2 * v * sizeof(int32_t);
+    }
+
+    // Build the whole file in memory, then write it at once
+    std::vector<char> buffer(end, 0);
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    for (uint64_t i = 0; i < v; i++)
+        buffer[header.edges_offset + i] = static_cast<char>(graph->get_open_mask(i));
+    if (header.flags & MAZE_FILE_ALIVE) {
+        auto words = reinterpret_cast<uint64_t *>(buffer.data() + header.alive_offset);
+        for (uint64_t i = 0; i < v; i++)
+            if (graph->is_alive(i))
+                words[i / 64] |= 1ull << (i % 64);
+    }
+    if (header.flags & MAZE_FILE_POSITIONS) {
+        auto positions = reinterpret_cast<int32_t *>(buffer.data() + header.positions_offset);
+        for (uint64_t i = 0; i < v; i++) {
+            positions[i] = graph->get_x(i);
+            positions[v + i] = graph->get_y(i);
+        }
+    }
+
+    std::ofstream file(filename, std::ios::binary);
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return file.good();
+}
+
+std::shared_ptr<Graph> MazeFile::load(const std::string &filename, uint64_t *seed) {
+    uint64_t size = 0;
+    auto mapping = map_file(filename, size);
+    if (!mapping || size < sizeof(MazeFileHeader))
+        return nullptr;
+
+    // Validate the header and the planes before pointing into the file
+    auto data = static_cast<const char *>(mapping.get());
+    auto header = reinterpret_cast<const MazeFileHeader *>(data);
+    if (std::memcmp(header->magic, "MAZE", 4) != 0 || header->version != MAZE_FILE_VERSION ||
+        header->type > static_cast<uint32_t>(GraphType::LAPLACIAN) || header->width <= 0 || header->height <= 0 ||
+        header->grid_size <= 0 ||
+        static_cast<int64_t>(header->width) * header->height > INT32_MAX)
+        return nullptr;
+    auto v = static_cast<uint64_t>(header->width) * header->height;
+    auto words = (v + 63) / 64;
+    if (!plane_fits(header->edges_offset, v, size) ||
+        ((header->flags & MAZE_FILE_ALIVE) && !plane_fits(header->alive_offset, words * sizeof(uint64_t), size)) ||
+        ((header->flags & MAZE_FILE_POSITIONS) && !plane_fits(header->positions_offset, 2 * v * sizeof(int32_t), size)))
+        return nullptr;
+
+    std::vector<int> xs;
+    std::vector<int> ys;
+    if (header->flags & MAZE_FILE_POSITIONS) {
+        auto positions = reinterpret_cast<const int32_t *>(data + header->positions_offset);
+        xs.assign(positions, positions + v);
+        ys.assign(positions + v, positions + 2 * v);
+    }
+    auto topology = std::make_shared<Topology>(header->width, header->height, static_cast<GraphType>(header->type),
+                                               header->grid_size, std::move(xs), std::move(ys));
+
+    // The node data are views of the mapped file, the edge plane is checked once against the topology
+    auto masks = reinterpret_cast<const uint8_t *>(data + header->edges_offset);
+    if (!edges_match_topology(masks, *topology))
+        return nullptr;
+    auto open = CowArray<uint8_t>(masks, v, mapping);
+    auto alive = (header->flags & MAZE_FILE_ALIVE)
+                 ? CowArray<uint64_t>(reinterpret_cast<const uint64_t *>(data + header->alive_offset), words, mapping)
+                 : CowArray<uint64_t>(words, ~0ull);
+
+    if (seed)
+        *seed = header->seed;
+    return std::make_shared<Graph>(std::move(topology), std::move(open), std::move(alive));
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <cstdint>
+#include "graph.h"
+
+/**
+ * Binary maze file (version 1), all values are stored in the native (little endian) byte order
+ *
+ * Layout:
+ * - 64 byte header: magic "MAZE", version, lattice type, flags, width, height, grid size, reserved,
+ *                   seed, offsets of the edge, alive and position planes
+ * - edge plane: bitmask of open slots of every node (1 byte per node, walls are the cleared slots)
+ * - alive plane (optional): alive flags packed into 64-bit words, 8 byte aligned
+ * - position plane (optional, non-grid mazes): X coordinates then Y coordinates (int32 per node), 8 byte aligned
+ *
+ * Loaded graphs point directly into the memory mapped file, nothing is parsed,
+ * the file is never written (changed pages are copied first)
+ */
+class MazeFile {
+public:
+    /**
+     * Saves the graph into a file
+     * Only lattice topologies can be saved (explicit topologies return false)
+     * @param filename Name of the file
+     * @param graph Graph to save
+     * @param seed Seed the graph was generated with (0 if unknown)
+     * @return True if the graph was saved, false otherwise
+     */
+    static bool save(const std::string &filename, const std::shared_ptr<Graph> &graph, uint64_t seed = 0);
+    /**
+     * Loads a graph from a file
+     * @param filename Name of the file
+     * @param seed Seed the graph was generated with (output, can be nullptr)
+     * @return Loaded graph, nullptr if the file can not be read or is not a valid maze file
+     */
+    static std::shared_ptr<Graph> load(const std::string &filename, uint64_t *seed = nullptr);
+};
@@ -0,0 +1,130 @@
+#include "maze_metrics.h"
+
+/**
+ * Runs BFS over the open edges
+ * @param maze Maze
+ * @param source Source node
+ * @param distance Distance of every node from the source, -1 if unreachable (output, sized by the caller)
+ * @param queue Queue of the BFS (sized by the caller)
+ * @return Number of reached nodes, the last one of them is the farthest from the source
+ */
+int bfs(const Graph &maze, int source, std::vector<int> &distance, std::vector<int> &queue) {
+    std::fill(distance.begin(), distance.end(), -1);
+    distance[source] = 0;
+    queue[0] = source;
+    int head = 0;
+    int tail = 1;
+    while (head < tail) {
+        auto current = queue[head++];
+        maze.for_each_neighbor(current, [&](int neighbor) {
+            if (distance[neighbor] == -1) {
+                distance[neighbor] = distance[current] + 1;
+                queue[tail++] = neighbor;
+            }
+        });
+    }
+    return tail;
+}
+
+MazeMetrics MazeMetrics::analyze(const Graph &maze) {
+    MazeMetrics metrics;
+    auto v = maze.get_v();
+    auto &topology = maze.get_topology();
+    auto degree = [&](int i) { return std::popcount(static_cast<unsigned>(maze.get_open_mask(i))); };
+
+    // Pass over the nodes (degrees)
+    for (int i = 0; i < v; i++) {
+        if (!maze.is_alive(i))
+            continue;
+        auto d = degree(i);
+        metrics.cells++;
+        metrics.edges += d;
+        metrics.degree_histogram[d]++;
+    }
+    metrics.edges /= 2;
+    metrics.dead_ends = metrics.degree_histogram[1];
+    for (int d = 3; d <= MAX_DEGREE; d++)
+        metrics.junctions += metrics.degree_histogram[d];
+
+    // Corridors start and end in nodes with other than two open edges, every corridor node is walked once
+    std::vector<uint8_t> walked(v, 0);
+    int64_t dead_end_edges = 0;
+    int64_t dead_ends_to_junctions = 0; // Dead ends of isolated corridors have no junction to reach
+    auto count_corridor = [&](int64_t length) {
+        if (metrics.corridor_lengths.size() <= static_cast<size_t>(length))
+            metrics.corridor_lengths.resize(length + 1, 0);
+        metrics.corridor_lengths[length]++;
+    };
+    for (int i = 0; i < v; i++) {
+        if (degree(i) == 2 || degree(i) == 0)
+            continue;
+        for (unsigned mask = maze.get_open_mask(i); mask; mask &= mask - 1) {
+            auto previous = i;
+            auto current = topology->get_neighbor(i, std::countr_zero(mask));
+            if (degree(current) == 2 && walked[current]) // Already walked from the other end
+                continue;
+            if (degree(current) != 2 && current < i) // Single edge corridor, counted from the smaller end
+                continue;
+
+            int64_t length = 1;
+            while (degree(current) == 2) {
+                walked[current] = 1;
+                auto next = -1;
+                maze.for_each_neighbor(current, [&](int neighbor) {
+                    if (neighbor != previous)
+                        next = neighbor;
+                });
+                previous = current;
+                current = next;
+                length++;
+            }
+            count_corridor(length);
+            if ((degree(i) == 1 && degree(current) >= 3) || (degree(current) == 1 && degree(i) >= 3)) {
+                dead_end_edges += length;
+                dead_ends_to_junctions++;
+            }
+        }
+    }
+    for (int i = 0; i < v; i++) { // Cycles made of corridor nodes only
+        if (degree(i) != 2 || walked[i])
+            continue;
+        int64_t length = 0;
+        auto previous = -1;
+        auto current = i;
+        do {
+            walked[current] = 1;
+            auto next = -1;
+            maze.for_each_neighbor(current, [&](int neighbor) {
+                if (next == -1 && neighbor != previous)
+                    next = neighbor;
+            });
+            previous = current;
+            current = next;
+            length++;
+        } while (current != i);
+        count_corridor(length);
+    }
+    if (dead_ends_to_junctions > 0)
+        metrics.river_factor = static_cast<double>(dead_end_edges) / static_cast<double>(dead_ends_to_junctions);
+
+    // Double BFS, the node farthest from the start is one end of the longest path (of a tree)
+    std::vector<int> distance(v);
+    std::vector<int> queue(v);
+    auto reached = bfs(maze, 0, distance, queue);
+    metrics.reachable = reached;
+    metrics.solution_length = distance[v - 1];
+    auto farthest = queue[reached - 1];
+    reached = bfs(maze, farthest, distance, queue);
+    metrics.longest_path = distance[queue[reached - 1]];
+
+    return metrics;
+}
+
+std::vector<MazeMetrics> MazeMetrics::analyze_batch(const std::vector<std::shared_ptr<Graph>> &mazes, unsigned threads) {
+    std::vector<MazeMetrics> metrics(mazes.size());
+    ThreadPool pool(threads);
+    pool.parallel_for(static_cast<int64_t>(mazes.size()), [&](int64_t i) {
+        metrics[i] = analyze(*mazes[i]);
+    });
+    return metrics;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "graph.h"
+#include "thread_pool.h"
+
+/**
+ * Structural metrics of a maze, all computed in one pass over the nodes, one pass along the corridors
+ * and a double BFS from the start
+ * Only alive nodes are counted
+ */
+struct MazeMetrics {
+    /** Number of alive nodes */
+    int64_t cells = 0;
+    /** Number of open edges */
+    int64_t edges = 0;
+    /** Number of dead ends (nodes with one open edge) */
+    int64_t dead_ends = 0;
+    /** Number of junctions (nodes with three or more open edges) */
+    int64_t junctions = 0;
+    /** Number of nodes by the number of their open edges */
+    std::array<int64_t, MAX_DEGREE + 1> degree_histogram{};
+    /** Number of corridors by their length in edges (corridors are chains of nodes with two open edges) */
+    std::vector<int64_t> corridor_lengths;
+    /** Number of edges of the shortest path from the start to the end (-1 if the maze is not solvable) */
+    int64_t solution_length = -1;
+    /** Number of nodes reachable from the start */
+    int64_t reachable = 0;
+    /** Longest shortest path of the part reachable from the start (exact for perfect mazes, a lower bound otherwise) */
+    int64_t longest_path = 0;
+    /** River factor, average number of edges from a dead end to the nearest junction (long, rare dead ends give high values), dead ends of isolated corridors (both ends dead ends) have no junction and are left out */
+    double river_factor = 0.0;
+
+    /**
+     * Computes the metrics of a maze
+     * @param maze Maze
+     * @return Metrics of the maze
+     */
+    static MazeMetrics analyze(const Graph &maze);
+
+    /**
+     * Computes the metrics of a batch of mazes in parallel (every maze is analyzed on one thread)
+     * @param mazes Mazes
+     * @param threads Number of threads (0 for the number of hardware threads)
+     * @return Metrics of the mazes (in the same order)
+     */
+    static std::vector<MazeMetrics> analyze_batch(const std::vector<std::shared_ptr<Graph>> &mazes,
+                                                  unsigned threads = 0);
+};
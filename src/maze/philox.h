@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+/**
+ * Streams of a seed reserved for the different users of random numbers (so they never share them)
+ */
+enum class RandomStream : uint64_t {
+    GENERATOR = 0,
+    JITTER = 1,
+    CELLULAR_AUTOMATA = 2,
+    SEAMS = 3
+};
+
+/**
+ * Counter-based random number generator (Philox4x32-10)
+ * Every number is a pure function of (seed, stream, position), so any run can be regenerated from its seed,
+ * and independent substreams (per tile, thread, trial, cell, ...) can be derived without any shared state
+ * Satisfies UniformRandomBitGenerator, so it works with the standard distributions and std::shuffle
+ */
+class Philox {
+private:
+    /** Seed (key of the block function) */
+    uint64_t seed;
+    /** Stream (upper half of the counter) */
+    uint64_t stream;
+    /** Index of the next block (lower half of the counter) */
+    uint64_t counter;
+    /** Current block of random numbers */
+    std::array<uint32_t, 4> block;
+    /** Number of used numbers of the current block */
+    int used;
+
+    /**
+     * Mixes the bits of a 64-bit value (SplitMix64 finalizer, a bijection)
+     * @param x Value
+     * @return Mixed value
+     */
+    static constexpr uint64_t mix(uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+public:
+    /** Type of the generated numbers */
+    using result_type = uint32_t;
+
+    /**
+     * Constructor
+     * @param seed Seed
+     * @param stream Stream
+     */
+    explicit Philox(uint64_t seed = 0, uint64_t stream = 0) : seed{seed}, stream{stream}, counter{0}, block{},
+                                                               used{4} {
+        // Nothing to do here :)
+    }
+
+    /**
+     * Constructor of a reserved stream
+     * @param seed Seed
+     * @param stream Reserved stream
+     */
+    Philox(uint64_t seed, RandomStream stream) : Philox(seed, static_cast<uint64_t>(stream)) {
+        // Nothing to do here :)
+    }
+
+    /**
+     * Smallest generated number
+     * @return 0
+     */
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    /**
+     * Largest generated number
+     * @return 2^32 - 1
+     */
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /**
+     * Computes the block of random numbers at the given position (ten Philox rounds)
+     * Stateless, so bulk users can compute any block directly (the loop over many counters vectorizes)
+     * @param seed Seed
+     * @param stream Stream
+     * @param counter Block index
+     * @return Four random numbers
+     */
+    static constexpr std::array<uint32_t, 4> generate(uint64_t seed, uint64_t stream, uint64_t counter) {
+        std::array<uint32_t, 4> c = {static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32),
+                                     static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)};
+        auto k0 = static_cast<uint32_t>(seed);
+        auto k1 = static_cast<uint32_t>(seed >> 32);
+#pragma GCC unroll 10
+        for (int round = 0; round < 10; round++) { // Unrolled, so loops over many counters can be vectorized
+            auto p0 = uint64_t{0xD2511F53} * c[0];
+            auto p1 = uint64_t{0xCD9E8D57} * c[2];
+            c = {static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k0, static_cast<uint32_t>(p1),
+                 static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k1, static_cast<uint32_t>(p0)};
+            k0 += 0x9E3779B9;
+            k1 += 0xBB67AE85;
+        }
+        return c;
+    }
+
+    /**
+     * Generates the next random number
+     * @return Random number
+     */
+    result_type operator()() {
+        if (used == 4) {
+            block = generate(seed, stream, counter++);
+            used = 0;
+        }
+        return block[used++];
+    }
+
+    /**
+     * Derives an independent generator, different ids give different streams
+     * (depends only on the seed, the stream and the id, not on the numbers generated so far)
+     * @param id Id of the substream (tile, thread, trial, cell, ...)
+     * @return Generator of the substream
+     */
+    [[nodiscard]] Philox substream(uint64_t id) const {
+        return Philox(seed, mix(stream + 0x9E3779B97F4A7C15ull * (id + 1)));
+    }
+
+    /**
+     * Getter for seed
+     * @return Seed
+     */
+    [[nodiscard]] uint64_t get_seed() const {
+        return seed;
+    }
+
+    /**
+     * Getter for stream
+     * @return Stream
+     */
+    [[nodiscard]] uint64_t get_stream() const {
+        return stream;
+    }
+};
@@ -0,0 +1,64 @@
+#include "rule.h"
+
+/**
+ * Parses a list of neighbor counts (at least one digit, every digit at most MAX_DEGREE)
+ * @param rulestring Rulestring
+ * @param position Position of the first digit, moved past the last one (input and output)
+ * @param counts Bitmask of the counts (output)
+ * @return True if the list is valid, false otherwise
+ */
+bool parse_counts(const std::string &rulestring, size_t &position, uint16_t &counts) {
+    auto first = position;
+    counts = 0;
+    for (; position < rulestring.length() && rulestring[position] >= '0' && rulestring[position] <= '9'; position++) {
+        auto count = rulestring[position] - '0';
+        if (count > MAX_DEGREE) // No node has that many neighbors
+            return false;
+        counts |= 1 << count;
+    }
+    return position > first;
+}
+
+Rule::Rule() : counts{0, 0} {
+    // Nothing to do here :)
+}
+
+bool Rule::parse(const std::string &rulestring, Rule &rule) {
+    uint16_t born, survive;
+    size_t position = 1;
+    if (rulestring.empty() || rulestring[0] != 'B' || !parse_counts(rulestring, position, born))
+        return false;
+    if (rulestring.compare(position, 2, "/S") != 0)
+        return false;
+    position += 2;
+    if (!parse_counts(rulestring, position, survive) || position != rulestring.length())
+        return false;
+
+    rule.counts = {born, survive};
+    return true;
+}
+
+bool Rule::is_valid(const std::string &rulestring) {
+    Rule rule;
+    return parse(rulestring, rule);
+}
+
+uint16_t Rule::get_born() const {
+    return counts[0];
+}
+
+uint16_t Rule::get_survive() const {
+    return counts[1];
+}
+
+std::string Rule::to_string() const {
+    std::string rulestring = "B";
+    for (int count = 0; count <= MAX_DEGREE; count++)
+        if ((counts[0] >> count) & 1)
+            rulestring += static_cast<char>('0' + count);
+    rulestring += "/S";
+    for (int count = 0; count <= MAX_DEGREE; count++)
+        if ((counts[1] >> count) & 1)
+            rulestring += static_cast<char>('0' + count);
+    return rulestring;
+}
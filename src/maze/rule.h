@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <cstdint>
+#include "lattice.h"
+
+/**
+ * Rule of a cellular automata in the B/S notation (for example B3/S12345)
+ * The rulestring is compiled once into bitmasks of the neighbor counts,
+ * so the next state of a node is a single lookup indexed by (alive, count)
+ */
+class Rule {
+private:
+    /** Bitmasks of the counts indexed by the alive flag (0 born rule, 1 survival rule), bit n is set for count n */
+    std::array<uint16_t, 2> counts;
+
+public:
+    /**
+     * Constructor of an empty rule (nothing is born, nothing survives)
+     */
+    Rule();
+
+    /**
+     * Compiles a rulestring (format B[0-8]+/S[0-8]+, counts are single digits since a node has at most MAX_DEGREE neighbors)
+     * @param rulestring Rulestring
+     * @param rule Compiled rule (output, unchanged if the rulestring is not valid)
+     * @return True if the rulestring is valid, false otherwise
+     */
+    static bool parse(const std::string &rulestring, Rule &rule);
+
+    /**
+     * Checks the format of a rulestring
+     * @param rulestring Rulestring
+     * @return True if the rulestring is valid, false otherwise
+     */
+    static bool is_valid(const std::string &rulestring);
+
+    /**
+     * Computes the next state of a node
+     * @param alive Alive flag of the node
+     * @param count Number of alive neighbors of the node
+     * @return True if the node is alive in the next generation
+     */
+    [[nodiscard]] bool next_state(bool alive, int count) const {
+        return (counts[alive] >> count) & 1;
+    }
+
+    /**
+     * Getter for the born rule
+     * @return Bitmask, bit n is set if a dead node with n alive neighbors becomes alive
+     */
+    [[nodiscard]] uint16_t get_born() const;
+
+    /**
+     * Getter for the survival rule
+     * @return Bitmask, bit n is set if an alive node with n alive neighbors stays alive
+     */
+    [[nodiscard]] uint16_t get_survive() const;
+
+    /**
+     * Converts the rule back to a rulestring (counts in ascending order)
+     * @return Rulestring
+     */
+    [[nodiscard]] std::string to_string() const;
+};
@@ -18,17 +18,15 @@ bool Solver::is_maze_solvable_bfs(std::shared_ptr<Graph> &maze, const std::pair<
         queue.erase(queue.begin());
 
         // If current node is the end node, return true
-        if (maze->get_nodes()[current]->get_x() == end.first && maze->get_nodes()[current]->get_y() == end.second)
+        if (maze->get_x(current) == end.first && maze->get_y(current) == end.second)
             return true;
 
         // Add all adjacent nodes to the queue
         std::vector<int> neighbors;
-        for (auto &node: maze->get_nodes()) {
-            if (maze->is_adjacent(current, node->get_v()) && !visited[node->get_v()] &&
-                maze->get_nodes()[node->get_v()]->is_alive()) {
-                neighbors.push_back(node->get_v());
-            }
-        }
+        maze->for_each_neighbor(current, [&](int neighbor) {
+            if (!visited[neighbor] && maze->is_alive(neighbor))
+                neighbors.push_back(neighbor);
+        });
 
         for (auto &neighbor: neighbors) {
             queue.push_back(neighbor);
@@ -61,17 +59,15 @@ Solver::solve_maze_bfs(std::shared_ptr<Graph> &maze, const std::pair<int, int> &
         queue.erase(queue.begin());
 
         // If current node is the end node, break
-        if (maze->get_nodes()[current]->get_x() == end.first && maze->get_nodes()[current]->get_y() == end.second)
+        if (maze->get_x(current) == end.first && maze->get_y(current) == end.second)
             break;
 
         // Add all adjacent nodes to the queue
         std::vector<int> neighbors;
-        for (auto &node: maze->get_nodes()) {
-            if (maze->is_adjacent(current, node->get_v()) && !visited[node->get_v()] &&
-                maze->get_nodes()[node->get_v()]->is_alive()) {
-                neighbors.push_back(node->get_v());
-            }
-        }
+        maze->for_each_neighbor(current, [&](int neighbor) {
+            if (!visited[neighbor] && maze->is_alive(neighbor))
+                neighbors.push_back(neighbor);
+        });
 
         for (auto &neighbor: neighbors) {
             queue.push_back(neighbor);
@@ -90,7 +86,7 @@ Solver::solve_maze_bfs(std::shared_ptr<Graph> &maze, const std::pair<int, int> &
     // Convert the shortest path to vector of pairs
     std::vector<std::pair<int, int>> result;
     for (auto &node: shortest_path)
-        result.emplace_back(maze->get_nodes()[node]->get_x(), maze->get_nodes()[node]->get_y());
+        result.emplace_back(maze->get_x(node), maze->get_y(node));
     std::reverse(result.begin(), result.end());
 
     return result;
@@ -195,22 +191,23 @@ Solver::solve_maze_a_star(std::shared_ptr<Graph> &maze, const std::pair<int, int
             break;
 
         // If the current node is not the end node, continue
-        for (auto &node: maze->get_nodes()) {
-            if (maze->is_adjacent(current, node->get_v()) && maze->get_nodes()[node->get_v()]->is_alive()) {
+        maze->for_each_neighbor(current, [&](int neighbor) {
+            if (maze->is_alive(neighbor)) {
                 // If the current path is better than the previous path, update the path
                 auto tentative_g_score = g_score[current] + 1;
-                if (tentative_g_score < g_score[node->get_v()]) {
-                    previous[node->get_v()] = current;
-                    g_score[node->get_v()] = tentative_g_score;
-                    f_score[node->get_v()] = g_score[node->get_v()];
+                if (tentative_g_score < g_score[neighbor]) {
+                    previous[neighbor] = current;
+                    g_score[neighbor] = tentative_g_score;
+                    f_score[neighbor] = g_score[neighbor];
                     if (heuristic != HeuristicType::CONSTANT_ZERO)
-                        f_score[node->get_v()] += h_funcs[static_cast<int>(heuristic)](node->get_x(), node->get_y(),
-                                                                                       end.first, end.second);
-                    if (std::find(list.begin(), list.end(), node->get_v()) == list.end())
-                        list.push_back(node->get_v());
+                        f_score[neighbor] += h_funcs[static_cast<int>(heuristic)](maze->get_x(neighbor),
+                                                                                  maze->get_y(neighbor), end.first,
+                                                                                  end.second);
+                    if (std::find(list.begin(), list.end(), neighbor) == list.end())
+                        list.push_back(neighbor);
                 }
             }
-        }
+        });
     }
 
     // Create the path
@@ -224,7 +221,60 @@ Solver::solve_maze_a_star(std::shared_ptr<Graph> &maze, const std::pair<int, int
     // Convert the path to a vector of pairs
     std::vector<std::pair<int, int>> result;
     for (auto &index: path)
-        result.emplace_back(maze->get_nodes()[index]->get_x(), maze->get_nodes()[index]->get_y());
+        result.emplace_back(maze->get_x(index), maze->get_y(index));
 
     return result;
 }
+
+int64_t Solver::solve_chunked_maze_bfs(ChunkedMaze &maze) {
+    auto end = maze.get_v() - 1;
+    std::vector<uint64_t> visited((maze.get_v() + 63) / 64, 0);
+    std::vector<int64_t> frontier = {0};
+    std::vector<int64_t> next_frontier;
+    visited[0] = 1;
+
+    // Level by level, so the distance is the number of finished levels
+    for (int64_t distance = 0; !frontier.empty(); distance++) {
+        for (auto cell: frontier) {
+            if (cell == end)
+                return distance;
+            for (unsigned mask = maze.get_open_mask(cell); mask; mask &= mask - 1) {
+                auto neighbor = maze.get_neighbor(cell, std::countr_zero(mask));
+                if (!((visited[neighbor / 64] >> (neighbor % 64)) & 1)) {
+                    visited[neighbor / 64] |= 1ull << (neighbor % 64);
+                    next_frontier.push_back(neighbor);
+                }
+            }
+        }
+        frontier.swap(next_frontier);
+        next_frontier.clear();
+    }
+
+    return -1;
+}
+
+bool Solver::is_maze_solvable_union_find(const std::shared_ptr<Graph> &maze, const std::pair<int, int> &start,
+                                         const std::pair<int, int> &end, ThreadPool &pool) {
+    constexpr int BLOCK = 4096; // Nodes per task
+    auto v = maze->get_v();
+    auto start_node = maze->get_nearest_node_to(start.first, start.second);
+    auto end_node = maze->get_nearest_node_to(end.first, end.second);
+    Concurrent_disjoint_union_sets sets(v);
+
+    // Every edge between alive nodes is merged once, from its smaller end
+    // (the start node counts as alive, the searches also leave a dead start node)
+    auto usable = [&](int i) { return i == start_node || maze->is_alive(i); };
+    pool.parallel_for((v + BLOCK - 1) / BLOCK, [&](int64_t block) {
+        auto last = std::min(static_cast<int>(block + 1) * BLOCK, v);
+        for (auto i = static_cast<int>(block) * BLOCK; i < last; i++) {
+            if (!usable(i))
+                continue;
+            maze->for_each_neighbor(i, [&](int neighbor) {
+                if (i < neighbor && usable(neighbor))
+                    sets.merge(i, neighbor);
+            });
+        }
+    });
+
+    return sets.same_set(start_node, end_node);
+}
@@ -4,6 +4,9 @@
 #include <vector>
 #include <climits>
 #include "graph.h"
+#include "chunked_maze.h"
+#include "thread_pool.h"
+#include "concurrent_disjoint_union_sets.h"
 
 /**
  * Solver class
@@ -63,6 +66,26 @@ public:
      * @return Vector of X and Y coordinates of the path from start to end
      */
     static std::vector<std::pair<int, int>> solve_maze_a_star(std::shared_ptr<Graph> &maze, const std::pair<int, int> &start, const std::pair<int, int> &end, HeuristicType heuristic = HeuristicType::EUCLIDEAN_DISTANCE);
+
+    /**
+     * Finds the length of the shortest path from the first to the last cell of an out-of-core maze using BFS
+     * (visited cells are kept in a bitset, one bit per cell)
+     * @param maze Maze to be solved
+     * @return Number of edges on the shortest path, -1 if the maze is not solvable
+     */
+    static int64_t solve_chunked_maze_bfs(ChunkedMaze &maze);
+
+    /**
+     * Checks if the maze is solvable by merging the open edges into disjoint sets on several threads
+     * (no path is built, meant for checking the connectivity after every generation of a Cellular Automata)
+     * @param maze Maze to be checked
+     * @param start Start position
+     * @param end End position
+     * @param pool Thread pool to run on
+     * @return True if the maze is solvable, false otherwise
+     */
+    static bool is_maze_solvable_union_find(const std::shared_ptr<Graph> &maze, const std::pair<int, int> &start,
+                                            const std::pair<int, int> &end, ThreadPool &pool);
 };
 
 
@@ -0,0 +1,82 @@
+#include "spatial_index.h"
+
+SpatialIndex::SpatialIndex() : origin_x{0}, origin_y{0}, max_x{0}, max_y{0}, cell_size{1}, columns{0}, rows{0},
+                               offsets(1, 0), entries() {
+    // Nothing to do here :)
+}
+
+SpatialIndex::SpatialIndex(const std::vector<int> &xs, const std::vector<int> &ys) : SpatialIndex() {
+    auto n = static_cast<int>(xs.size());
+    if (n == 0)
+        return;
+
+    // Bounding box of the nodes
+    auto [min_x_it, max_x_it] = std::minmax_element(xs.begin(), xs.end());
+    auto [min_y_it, max_y_it] = std::minmax_element(ys.begin(), ys.end());
+    origin_x = *min_x_it;
+    origin_y = *min_y_it;
+    max_x = *max_x_it;
+    max_y = *max_y_it;
+
+    // Size the buckets so that there is about one node per bucket
+    auto area = static_cast<double>(max_x - origin_x + 1) * static_cast<double>(max_y - origin_y + 1);
+    cell_size = std::max(1, static_cast<int>(std::sqrt(area / n)));
+    columns = (max_x - origin_x) / cell_size + 1;
+    rows = (max_y - origin_y) / cell_size + 1;
+
+    // Counting sort of the nodes into the buckets
+    auto bucket_of = [&](int i) {
+        return ((xs[i] - origin_x) / cell_size) * rows + (ys[i] - origin_y) / cell_size;
+    };
+    offsets.assign(columns * rows + 1, 0);
+    for (int i = 0; i < n; i++)
+        offsets[bucket_of(i) + 1]++;
+    for (int i = 0; i < columns * rows; i++)
+        offsets[i + 1] += offsets[i];
+    entries.resize(n);
+    std::vector<int> next(offsets.begin(), offsets.end() - 1);
+    for (int i = 0; i < n; i++)
+        entries[next[bucket_of(i)]++] = {xs[i], ys[i], i};
+}
+
+int SpatialIndex::find_nearest(int x, int y, const std::function<bool(int)> &accept) const {
+    if (entries.empty())
+        return -1;
+
+    // The search starts from the query point projected onto the bounding box, distances to the nodes only shrink by that
+    auto cx = std::clamp(x, origin_x, max_x);
+    auto cy = std::clamp(y, origin_y, max_y);
+    auto column = (cx - origin_x) / cell_size;
+    auto row = (cy - origin_y) / cell_size;
+
+    auto nearest = -1;
+    auto nearest_distance = LLONG_MAX;
+    for (int r = 0; r <= std::max(columns, rows); r++) {
+        // Visit the buckets in Chebyshev distance r from the bucket of the query point
+        for (int i = std::max(0, column - r); i <= std::min(columns - 1, column + r); i++) {
+            auto step = (i == column - r || i == column + r) ? 1 : 2 * r; // Inner columns only have two ring buckets
+            for (int j = row - r; j <= row + r; j += std::max(step, 1)) {
+                if (j < 0 || j >= rows)
+                    continue;
+                for (int e = offsets[i * rows + j]; e < offsets[i * rows + j + 1]; e++) {
+                    auto dx = static_cast<long long>(entries[e].x - x);
+                    auto dy = static_cast<long long>(entries[e].y - y);
+                    auto distance = dx * dx + dy * dy;
+                    if ((distance < nearest_distance || (distance == nearest_distance && entries[e].v < nearest)) &&
+                        accept(entries[e].v)) {
+                        nearest = entries[e].v;
+                        nearest_distance = distance;
+                    }
+                }
+            }
+        }
+
+        // Every bucket in the next ring is at least r buckets away from the query point
+        // (a node there at the same distance can still win the tie by a smaller index)
+        auto bound = static_cast<long long>(r) * cell_size;
+        if (nearest != -1 && nearest_distance < bound * bound)
+            break;
+    }
+
+    return nearest;
+}
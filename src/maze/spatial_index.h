@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <climits>
+#include <algorithm>
+#include <functional>
+
+/**
+ * Uniform grid spatial hash of node positions
+ * Nodes are sorted into square buckets (about one node per bucket),
+ * nearest node queries search rings of buckets around the query point
+ */
+class SpatialIndex {
+private:
+    /**
+     * Node stored in a bucket (position is kept next to the index for cache friendly scans)
+     */
+    struct Entry {
+        /** X coordinate */
+        int x;
+        /** Y coordinate */
+        int y;
+        /** Node index */
+        int v;
+    };
+
+    /** X coordinate of the left edge of the bucket grid */
+    int origin_x;
+    /** Y coordinate of the top edge of the bucket grid */
+    int origin_y;
+    /** X coordinate of the right edge of the bucket grid */
+    int max_x;
+    /** Y coordinate of the bottom edge of the bucket grid */
+    int max_y;
+    /** Size of a bucket in pixels */
+    int cell_size;
+    /** Number of bucket columns */
+    int columns;
+    /** Number of bucket rows */
+    int rows;
+    /** Offsets of the buckets in the entries array (columns * rows + 1 values) */
+    std::vector<int> offsets;
+    /** Entries sorted by bucket */
+    std::vector<Entry> entries;
+
+public:
+    /**
+     * Constructor of an empty index
+     */
+    SpatialIndex();
+
+    /**
+     * Constructor
+     * @param xs X coordinates of the nodes
+     * @param ys Y coordinates of the nodes
+     */
+    SpatialIndex(const std::vector<int> &xs, const std::vector<int> &ys);
+
+    /**
+     * Finds the nearest accepted node to the given coordinates
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @param accept Filter of the nodes (for example alive nodes only)
+     * @return Node index of the nearest accepted node, -1 if no node is accepted
+     */
+    [[nodiscard]] int find_nearest(int x, int y, const std::function<bool(int)> &accept) const;
+};
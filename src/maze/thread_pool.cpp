@@ -0,0 +1,71 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(unsigned threads) : pending{0}, stopping{false} {
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    workers.reserve(threads);
+    for (unsigned i = 0; i < threads; i++)
+        workers.emplace_back(&ThreadPool::work, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    task_available.notify_all();
+    for (auto &worker: workers)
+        worker.join();
+}
+
+unsigned ThreadPool::get_size() const {
+    return static_cast<unsigned>(workers.size());
+}
+
+void ThreadPool::work() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            task_available.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) // Stopping and nothing left to do
+                return;
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending--;
+        }
+        task_finished.notify_all();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(task));
+        pending++;
+    }
+    task_available.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    task_finished.wait(lock, [this] { return pending == 0; });
+}
+
+void ThreadPool::parallel_for(int64_t count, const std::function<void(int64_t)> &f) {
+    // One task per worker, the tasks take the indices from a shared counter
+    std::atomic<int64_t> next{0};
+    for (unsigned i = 0; i < get_size(); i++) {
+        submit([&] {
+            for (auto index = next++; index < count; index = next++)
+                f(index);
+        });
+    }
+    wait();
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+#include <cstdint>
+
+/**
+ * Fixed size pool of worker threads
+ */
+class ThreadPool {
+private:
+    /** Worker threads */
+    std::vector<std::thread> workers;
+    /** Tasks waiting for a worker */
+    std::queue<std::function<void()>> tasks;
+    /** Number of tasks submitted and not finished yet */
+    size_t pending;
+    /** True if the workers should exit */
+    bool stopping;
+    /** Mutex guarding the tasks, pending and stopping */
+    std::mutex mutex;
+    /** Signals new tasks (and stopping) to the workers */
+    std::condition_variable task_available;
+    /** Signals finished tasks to the waiting threads */
+    std::condition_variable task_finished;
+
+    /**
+     * Main loop of a worker thread
+     */
+    void work();
+
+public:
+    /**
+     * Constructor, starts the workers
+     * @param threads Number of worker threads (0 for the number of hardware threads)
+     */
+    explicit ThreadPool(unsigned threads = 0);
+
+    /**
+     * Destructor, finishes the submitted tasks and joins the workers
+     */
+    ~ThreadPool();
+
+    /**
+     * Getter for size
+     * @return Number of worker threads
+     */
+    [[nodiscard]] unsigned get_size() const;
+
+    /**
+     * Submits a task to be run by one of the workers
+     * @param task Task
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * Waits until all the submitted tasks are finished
+     */
+    void wait();
+
+    /**
+     * Calls the function for every index from 0 to count - 1 on the workers and waits for all of them
+     * (indices are handed out one by one, so uneven work per index is balanced)
+     * @param count Number of indices
+     * @param f Function to call with the index
+     */
+    void parallel_for(int64_t count, const std::function<void(int64_t)> &f);
+};
@@ -0,0 +1,235 @@
+#include "topology.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+/** Lattice slot of the offset (di, dj) at position (di + 1) * 3 + (dj + 1) (hexagonal diagonals are handled apart) */
+constexpr int LATTICE_SLOT[9] = {4, 0, 6, 2, -1, 3, 7, 1, 5};
+
+Topology::Topology(int width, int height, GraphType type, int grid_size, std::vector<int> xs, std::vector<int> ys)
+        : width{width}, height{height}, v{width * height}, implicit{true}, type{type}, grid_size{grid_size},
+          xs{std::move(xs)}, ys{std::move(ys)}, displacement{0} {
+    degree = type == GraphType::ORTHOGONAL ? 4 : type == GraphType::HEXAGONAL ? 6 : 8;
+    if (this->xs.empty())
+        return;
+
+    // Noisy positions stay close to the lattice, so the lattice search only has to look a little further
+    auto max_distance = 0ll;
+    for (int i = 0; i < width; i++) {
+        auto first = i * height;
+        auto x = get_lattice_x(first);
+        auto y = get_lattice_y(first);
+        for (int j = 0; j < height; j++) {
+            auto dx = static_cast<long long>(this->xs[first + j] - x);
+            auto dy = static_cast<long long>(this->ys[first + j] - y - j * grid_size);
+            max_distance = std::max(max_distance, dx * dx + dy * dy);
+        }
+    }
+    displacement = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(max_distance))));
+    if (displacement > grid_size) // Positions moved too far for the rings of lattice cells
+        index = SpatialIndex(this->xs, this->ys);
+}
+
+Topology::Topology(int width, int height, const std::vector<std::pair<int, int>> &edges, std::vector<int> xs,
+                   std::vector<int> ys)
+        : width{width}, height{height}, v{width * height}, degree{0}, implicit{false}, type{GraphType::ORTHOGONAL},
+          grid_size{0}, offsets(v + 1, 0), xs{std::move(xs)}, ys{std::move(ys)}, displacement{0} {
+    // Count the degrees, then turn them into the row offsets
+    for (auto &[src, dest]: edges) {
+        offsets[src + 1]++;
+        offsets[dest + 1]++;
+    }
+    for (int i = 1; i <= v; i++)
+        degree = std::max(degree, offsets[i]);
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    // Fill the rows, both directions of an edge know about each other
+    neighbors.resize(offsets[v]);
+    reverse.resize(offsets[v]);
+    std::vector<int> next(offsets.begin(), offsets.end() - 1);
+    for (auto &[src, dest]: edges) {
+        auto forward = next[src]++;
+        auto backward = next[dest]++;
+        neighbors[forward] = dest;
+        neighbors[backward] = src;
+        reverse[forward] = backward;
+        reverse[backward] = forward;
+    }
+
+    index = SpatialIndex(this->xs, this->ys);
+}
+
+int Topology::get_lattice_neighbor(int i, int j, int slot) const {
+    switch (type) {
+        case GraphType::ORTHOGONAL:
+            return Lattice<GraphType::ORTHOGONAL>::neighbor(i, j, width, height, slot);
+        case GraphType::HEXAGONAL:
+            return Lattice<GraphType::HEXAGONAL>::neighbor(i, j, width, height, slot);
+        default:
+            return Lattice<GraphType::LAPLACIAN>::neighbor(i, j, width, height, slot);
+    }
+}
+
+int Topology::find_nearest_lattice(int x, int y, const std::function<bool(int)> &accept) const {
+    // The search starts from the query point projected onto the bounding box, distances to the nodes only shrink by that
+    auto cx = std::clamp(x, grid_size, width * grid_size);
+    auto cy = std::clamp(y, grid_size, height * grid_size + (type == GraphType::HEXAGONAL ? grid_size / 2 : 0));
+    // Cell of the query point, the node of the cell is at most half a cell away on every axis (a whole cell in Y on hexagonal lattices)
+    auto column = std::clamp((cx - grid_size + grid_size / 2) / grid_size, 0, width - 1);
+    auto row = std::clamp((cy - grid_size + grid_size / 2) / grid_size, 0, height - 1);
+
+    auto nearest = -1;
+    auto nearest_distance = LLONG_MAX;
+    for (int r = 0; r <= std::max(width, height); r++) {
+        // Visit the cells in Chebyshev distance r from the cell of the query point
+        for (int i = std::max(0, column - r); i <= std::min(width - 1, column + r); i++) {
+            auto step = (i == column - r || i == column + r) ? 1 : 2 * r; // Inner columns only have two ring cells
+            for (int j = row - r; j <= row + r; j += std::max(step, 1)) {
+                if (j < 0 || j >= height)
+                    continue;
+                auto node = i * height + j;
+                auto dx = static_cast<long long>(get_x(node) - x);
+                auto dy = static_cast<long long>(get_y(node) - y);
+                auto distance = dx * dx + dy * dy;
+                if ((distance < nearest_distance || (distance == nearest_distance && node < nearest)) && accept(node)) {
+                    nearest = node;
+                    nearest_distance = distance;
+                }
+            }
+        }
+
+        // Every node in the next ring is at least r cells away (the query cell and hexagonal shift take one cell at most)
+        // minus the displacement of the node from its lattice position, a node there at the same distance can still
+        // win the tie by a smaller index
+        auto bound = static_cast<long long>(r) * grid_size - displacement;
+        if (nearest != -1 && bound >= 0 && nearest_distance < bound * bound)
+            break;
+    }
+
+    return nearest;
+}
+
+int Topology::get_width() const {
+    return width;
+}
+
+int Topology::get_height() const {
+    return height;
+}
+
+int Topology::get_v() const {
+    return v;
+}
+
+int Topology::get_max_degree() const {
+    return degree;
+}
+
+bool Topology::is_implicit() const {
+    return implicit;
+}
+
+GraphType Topology::get_type() const {
+    return type;
+}
+
+int Topology::get_grid_size() const {
+    return grid_size;
+}
+
+bool Topology::has_stored_positions() const {
+    return !xs.empty();
+}
+
+int Topology::get_lattice_x(int src) const {
+    return (src / height) * grid_size + grid_size;
+}
+
+int Topology::get_lattice_y(int src) const {
+    auto y = (src % height) * grid_size + grid_size;
+    if (type == GraphType::HEXAGONAL && (src / height) % 2 == 1)
+        y += grid_size / 2;
+    return y;
+}
+
+int Topology::get_x(int src) const {
+    if (!xs.empty())
+        return xs[src];
+    return get_lattice_x(src);
+}
+
+int Topology::get_y(int src) const {
+    if (!ys.empty())
+        return ys[src];
+    return get_lattice_y(src);
+}
+
+uint8_t Topology::get_slot_mask(int src) const {
+    if (!implicit)
+        return static_cast<uint8_t>((1u << (offsets[src + 1] - offsets[src])) - 1);
+
+    switch (type) {
+        case GraphType::ORTHOGONAL:
+            return Lattice<GraphType::ORTHOGONAL>::slot_mask(src / height, src % height, width, height);
+        case GraphType::HEXAGONAL:
+            return Lattice<GraphType::HEXAGONAL>::slot_mask(src / height, src % height, width, height);
+        default:
+            return Lattice<GraphType::LAPLACIAN>::slot_mask(src / height, src % height, width, height);
+    }
+}
+
+int Topology::get_neighbor(int src, int slot) const {
+    if (!implicit)
+        return slot < offsets[src + 1] - offsets[src] ? neighbors[offsets[src] + slot] : -1;
+    if (slot >= degree)
+        return -1;
+    return get_lattice_neighbor(src / height, src % height, slot);
+}
+
+int Topology::get_reverse_slot(int src, int slot) const {
+    if (!implicit)
+        return reverse[offsets[src] + slot] - offsets[neighbors[offsets[src] + slot]];
+    return slot ^ 1; // Lattice slots come in pairs of opposite directions
+}
+
+int Topology::find_slot(int src, int dest) const {
+    if (!implicit) {
+        for (int position = offsets[src]; position < offsets[src + 1]; position++)
+            if (neighbors[position] == dest)
+                return position - offsets[src];
+        return -1;
+    }
+
+    if (dest < 0 || dest >= v)
+        return -1;
+    auto i = src / height;
+    auto di = dest / height - i;
+    auto dj = dest % height - src % height;
+    if (di < -1 || di > 1 || dj < -1 || dj > 1)
+        return -1;
+
+    // Hexagonal diagonals lead up on even columns and down on odd columns
+    if (type == GraphType::HEXAGONAL && di != 0 && dj != 0)
+        return dj == (i % 2 == 0 ? -1 : 1) ? (di < 0 ? 4 : 5) : -1;
+
+    auto slot = LATTICE_SLOT[(di + 1) * 3 + (dj + 1)];
+    return slot < degree ? slot : -1;
+}
+
+std::vector<std::pair<int, int>> Topology::get_edges() const {
+    std::vector<std::pair<int, int>> edges;
+    for (int src = 0; src < v; src++) {
+        for (int slot = 0; slot < degree; slot++) {
+            auto dest = get_neighbor(src, slot);
+            if (src < dest) // Every edge only once (also skips missing neighbors)
+                edges.emplace_back(src, dest);
+        }
+    }
+    return edges;
+}
+
+int Topology::find_nearest(int x, int y, const std::function<bool(int)> &accept) const {
+    if (implicit && displacement <= grid_size)
+        return find_nearest_lattice(x, y, accept);
+    return index.find_nearest(x, y, accept);
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <numeric>
+#include <utility>
+#include <cstdint>
+#include <functional>
+#include "spatial_index.h"
+#include "lattice.h"
+#include "../const.h"
+
+/**
+ * Fixed topology of a graph (which nodes can be connected) together with the positions of the nodes
+ * Neighbors of a node are addressed by slots 0 ... MAX_DEGREE - 1, the opposite direction
+ * of an edge is the reverse slot in the neighbor's row
+ *
+ * Two representations are supported:
+ * - implicit lattice, neighbors and positions are computed from the column i and row j of the node (v = i * height + j)
+ *   with the slots of Lattice
+ * - explicit compressed sparse row (CSR) format, slot k of node v is neighbors[offsets[v] + k]
+ */
+class Topology {
+private:
+    /** Width of the graph */
+    int width;
+    /** Height of the graph */
+    int height;
+    /** Number of vertices */
+    int v;
+    /** Maximal number of neighbors of a node (number of used slots) */
+    int degree;
+    /** True if the neighbors are computed from the lattice position, false if they are stored in CSR */
+    bool implicit;
+    /** Lattice type (implicit topology only) */
+    GraphType type;
+    /** Distance of two neighboring lattice nodes in pixels (implicit topology only) */
+    int grid_size;
+    /** Offsets of the neighbor rows (v + 1 values, explicit topology only) */
+    std::vector<int> offsets;
+    /** Flat array of neighbors (explicit topology only) */
+    std::vector<int> neighbors;
+    /** Position of the opposite direction for every position in the flat array (explicit topology only) */
+    std::vector<int> reverse;
+    /** X coordinates of the nodes (empty if computed from the lattice position) */
+    std::vector<int> xs;
+    /** Y coordinates of the nodes (empty if computed from the lattice position) */
+    std::vector<int> ys;
+    /** Largest distance of a stored node position from its lattice position in pixels (implicit topology only) */
+    int displacement;
+    /** Spatial index of the stored coordinates (empty if the lattice search finds the nodes) */
+    SpatialIndex index;
+
+    /**
+     * Computes the X coordinate of a lattice node without noise
+     * @param src Node index
+     * @return X coordinate
+     */
+    [[nodiscard]] int get_lattice_x(int src) const;
+
+    /**
+     * Computes the Y coordinate of a lattice node without noise
+     * @param src Node index
+     * @return Y coordinate
+     */
+    [[nodiscard]] int get_lattice_y(int src) const;
+
+    /**
+     * Computes the neighbor of a lattice node
+     * @param i Column of the node
+     * @param j Row of the node
+     * @param slot Slot
+     * @return Node index of the neighbor, -1 if the slot leads out of the lattice
+     */
+    [[nodiscard]] int get_lattice_neighbor(int i, int j, int slot) const;
+
+    /**
+     * Finds the nearest accepted node of a lattice (nodes are at most displacement away from their lattice positions)
+     * Searches rings of lattice cells around the cell of the query point
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @param accept Filter of the nodes
+     * @return Node index of the nearest accepted node, -1 if no node is accepted
+     */
+    [[nodiscard]] int find_nearest_lattice(int x, int y, const std::function<bool(int)> &accept) const;
+
+public:
+    /**
+     * Constructor of an implicit lattice topology
+     * @param width Width of the graph
+     * @param height Height of the graph
+     * @param type Lattice type
+     * @param grid_size Distance of two neighboring nodes in pixels
+     * @param xs X coordinates of the nodes (empty to compute them from the lattice position)
+     * @param ys Y coordinates of the nodes (empty to compute them from the lattice position)
+     */
+    Topology(int width, int height, GraphType type, int grid_size, std::vector<int> xs = {}, std::vector<int> ys = {});
+
+    /**
+     * Constructor of an explicit (CSR) topology
+     * Every edge is stored in both directions, edges must not repeat and no node can have more than MAX_DEGREE edges
+     * @param width Width of the graph
+     * @param height Height of the graph
+     * @param edges List of undirected edges (pairs of vertex indices)
+     * @param xs X coordinates of the nodes
+     * @param ys Y coordinates of the nodes
+     */
+    Topology(int width, int height, const std::vector<std::pair<int, int>> &edges, std::vector<int> xs,
+             std::vector<int> ys);
+
+    /**
+     * Getter for width
+     * @return Width of the graph
+     */
+    [[nodiscard]] int get_width() const;
+
+    /**
+     * Getter for height
+     * @return Height of the graph
+     */
+    [[nodiscard]] int get_height() const;
+
+    /**
+     * Getter for vertex count
+     * @return Number of vertices
+     */
+    [[nodiscard]] int get_v() const;
+
+    /**
+     * Getter for maximal degree
+     * @return Maximal number of neighbors of a node (slots 0 ... degree - 1 can be used)
+     */
+    [[nodiscard]] int get_max_degree() const;
+
+    /**
+     * Getter for implicit flag
+     * @return True if the topology is an implicit lattice, false if it is stored in CSR
+     */
+    [[nodiscard]] bool is_implicit() const;
+
+    /**
+     * Getter for lattice type
+     * @return Lattice type (meaningful for implicit topologies only)
+     */
+    [[nodiscard]] GraphType get_type() const;
+
+    /**
+     * Getter for grid size
+     * @return Distance of two neighboring lattice nodes in pixels (meaningful for implicit topologies only)
+     */
+    [[nodiscard]] int get_grid_size() const;
+
+    /**
+     * Checks if the positions of the nodes are stored instead of computed from the lattice position
+     * @return True if the positions are stored, false otherwise
+     */
+    [[nodiscard]] bool has_stored_positions() const;
+
+    /**
+     * Getter for X coordinate of a node
+     * @param src Node index
+     * @return X coordinate
+     */
+    [[nodiscard]] int get_x(int src) const;
+
+    /**
+     * Getter for Y coordinate of a node
+     * @param src Node index
+     * @return Y coordinate
+     */
+    [[nodiscard]] int get_y(int src) const;
+
+    /**
+     * Getter for the mask of the existing slots of a node
+     * @param src Node index
+     * @return Bitmask, bit k is set if slot k leads to a neighbor
+     */
+    [[nodiscard]] uint8_t get_slot_mask(int src) const;
+
+    /**
+     * Getter for the neighbor in the given slot
+     * @param src Node index
+     * @param slot Slot
+     * @return Node index of the neighbor, -1 if there is no neighbor in the slot
+     */
+    [[nodiscard]] int get_neighbor(int src, int slot) const;
+
+    /**
+     * Getter for the opposite direction of the given slot
+     * @param src Node index
+     * @param slot Slot (must lead to a neighbor)
+     * @return Slot of the same edge in the row of the neighbor
+     */
+    [[nodiscard]] int get_reverse_slot(int src, int slot) const;
+
+    /**
+     * Finds the slot of the edge between the given nodes
+     * Lattice slots are computed from the offset of the nodes, explicit rows have MAX_DEGREE entries at most
+     * @param src Node index
+     * @param dest Node index
+     * @return Slot in the row of src, -1 if the nodes are not neighbors
+     */
+    [[nodiscard]] int find_slot(int src, int dest) const;
+
+    /**
+     * Lists all edges of the topology (every edge once)
+     * @return List of undirected edges
+     */
+    [[nodiscard]] std::vector<std::pair<int, int>> get_edges() const;
+
+    /**
+     * Finds the nearest accepted node to the given coordinates
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @param accept Filter of the nodes (for example alive nodes only)
+     * @return Node index of the nearest accepted node, -1 if no node is accepted
+     */
+    [[nodiscard]] int find_nearest(int x, int y, const std::function<bool(int)> &accept) const;
+};